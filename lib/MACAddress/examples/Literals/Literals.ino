@@ -0,0 +1,35 @@
+/*
+ * This sketch shows how constant addresses can be written as "_mac" literals:
+ * they are parsed and validated at compile time, so they cost neither startup
+ * time nor RAM.
+ */
+#include <Arduino.h>
+#include <MACAddress.h>
+
+const uint32_t BAUD_RATE{115200};
+
+// folded into the code wherever it is used
+constexpr MAC48 gateway = "0:8:ab:cd:0:3"_mac;
+
+// a table stored in flash
+const MAC48 known[] PROGMEM = {"CA:FE:BA:BE:00:01"_mac, "DE-AD-BE-EF-FE-ED"_mac,
+                               "8::12:34:56:78"_mac};
+
+// a malformed literal does not compile:
+// constexpr MAC48 wrong = "0:8:ab:cd:0"_mac;
+
+void setup(void) {
+  Serial.begin(BAUD_RATE);
+
+  MACAddress mac{gateway}; // no parsing: the six octets are just copied
+  Serial.print(F("gateway: "));
+  Serial.println(mac);
+
+  char buffer[MAC48::str_size];
+  for (auto i = 0; i != 3; ++i) {
+    Serial.print(F("known: "));
+    Serial.println(MAC48::read_P(&known[i]).toString(buffer));
+  }
+}
+
+void loop(void) {}
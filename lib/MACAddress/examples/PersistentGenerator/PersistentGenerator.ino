@@ -0,0 +1,40 @@
+/*
+ * This sketch hands out a new address of an MA-L block every second, keeping
+ * track of them in the EEPROM: after a reset it goes on from where it was,
+ * never reissuing an address.
+ *
+ * The EEPROM is written once every 64 addresses, each time to the next slot
+ * of a ring taking the first 256 bytes.
+ */
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <MACAddress.h>
+#include <MACAddressGenerator.h>
+
+const uint32_t BAUD_RATE{115200};
+
+MACAddressEEPROMStorage storage{0, 256};
+MACAddressGenerator generator{storage, "0:8:ab:0:0:0"_mac, MA::L, 64};
+
+void setup(void) {
+  Serial.begin(BAUD_RATE);
+#if defined(ESP8266) || defined(ESP32)
+  EEPROM.begin(256);
+#endif
+
+  if (!generator.begin()) {
+    Serial.println(F("cannot read the EEPROM"));
+    return;
+  }
+  Serial.print(F("resuming from extension id "));
+  Serial.println(static_cast<unsigned long>(generator.position()), HEX);
+}
+
+void loop(void) {
+  MACAddress mac;
+  if (generator.next(mac))
+    Serial.println(mac);
+  else
+    Serial.println(F("no address left"));
+  delay(1000);
+}
@@ -0,0 +1,90 @@
+/*
+ *      @file: bench.cpp
+ *
+ * Harness implementation and entry point of the MACAddress benchmarks.
+ */
+
+#include "bench.h"
+
+#include <atomic>
+#include <new>
+
+static std::atomic<uint64_t> _allocations{0};
+
+void *operator new(size_t size) {
+  _allocations.fetch_add(1, std::memory_order_relaxed);
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete[](void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+namespace bench {
+
+static const char *_filter{nullptr};
+static const char *_group{""};
+static Group *_groups{nullptr};
+
+uint64_t allocations(void) {
+  return _allocations.load(std::memory_order_relaxed);
+}
+
+bool selected(const char *name) {
+  return _filter == nullptr || strstr(_group, _filter) != nullptr ||
+         strstr(name, _filter) != nullptr;
+}
+
+void report(const char *name, double ns_per_op, double allocs_per_op,
+            uint64_t items_per_op) {
+  if (items_per_op > 1)
+    printf("  %-44s %12.1f ns/op %8.2f allocs/op %9.3f ns/item %9.1f "
+           "Mitems/s\n",
+           name, ns_per_op, allocs_per_op, ns_per_op / items_per_op,
+           1e3 * items_per_op / ns_per_op);
+  else
+    printf("  %-44s %12.1f ns/op %8.2f allocs/op\n", name, ns_per_op,
+           allocs_per_op);
+  fflush(stdout);
+}
+
+void counter(const char *name, double value, const char *unit) {
+  if (!selected(name))
+    return;
+
+  printf("  %-44s %12.2f %s\n", name, value, unit);
+  fflush(stdout);
+}
+
+Group::Group(const char *name, void (*fn)(void))
+    : name{name}, fn{fn}, next{nullptr} {
+  // keep the registration order of each translation unit
+  Group **tail = &_groups;
+  while (*tail)
+    tail = &(*tail)->next;
+  *tail = this;
+}
+
+} // namespace bench
+
+int main(int argc, char *argv[]) {
+  if (argc > 1)
+    bench::_filter = argv[1];
+
+  for (bench::Group *g = bench::_groups; g; g = g->next) {
+    bench::_group = g->name;
+    printf("%s\n", g->name);
+    g->fn();
+  }
+
+  return 0;
+}
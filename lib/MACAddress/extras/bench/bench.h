@@ -0,0 +1,119 @@
+#ifndef _bench_h_
+#define _bench_h_
+
+/*
+ *      @file: bench.h
+ *
+ * Tiny microbenchmark harness for the host build of the MACAddress library.
+ *
+ * Every benchmark is a callable run in a calibrated loop; the harness reports
+ * nanoseconds and heap allocations (counted by replacing the global operator
+ * new) per operation. Batch benchmarks pass the number of items processed by
+ * a single call so that the throughput is reported per item as well.
+ *
+ * Benchmarks are grouped in functions registered through BENCH_GROUP() and
+ * can be selected from the command line by a substring of their name or of
+ * the name of their group:
+ *
+ *   macaddress_bench [filter]
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chrono>
+
+#include <Arduino.h>
+
+namespace bench {
+
+// Number of calls to the global operator new since the program start.
+uint64_t allocations(void);
+
+// Current benchmark name filter (set from the command line).
+bool selected(const char *name);
+
+void report(const char *name, double ns_per_op, double allocs_per_op,
+            uint64_t items_per_op);
+
+// Reports a value measured by the benchmark itself (e.g. writes per op).
+void counter(const char *name, double value, const char *unit);
+
+// Prevent the compiler from optimizing away the computation of value.
+template <typename T> inline void keep(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber(void) { asm volatile("" : : : "memory"); }
+
+template <typename F> void run(const char *name, F f, uint64_t items = 1) {
+  typedef std::chrono::steady_clock clock;
+
+  if (!selected(name))
+    return;
+
+  // warm up and calibrate the number of iterations to about 200ms
+  uint64_t iterations{1};
+  for (;;) {
+    clock::time_point start = clock::now();
+    for (uint64_t i = 0; i != iterations; ++i)
+      f();
+    double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    if (elapsed > 0.05 || iterations >= (1ull << 40)) {
+      double target = 0.2 / (elapsed / iterations);
+      iterations = target < 1 ? 1 : static_cast<uint64_t>(target);
+      break;
+    }
+    iterations *= 4;
+  }
+
+  uint64_t allocs = allocations();
+  clock::time_point start = clock::now();
+  for (uint64_t i = 0; i != iterations; ++i)
+    f();
+  double elapsed =
+      std::chrono::duration<double, std::nano>(clock::now() - start).count();
+  allocs = allocations() - allocs;
+
+  report(name, elapsed / iterations,
+         static_cast<double>(allocs) / iterations, items);
+}
+
+// Print sink discarding everything but counting the write calls.
+class NullPrint : public Print {
+public:
+  uint64_t writes{0};
+  uint64_t bytes{0};
+
+  virtual size_t write(uint8_t c) {
+    (void)c;
+    ++writes;
+    ++bytes;
+    return 1;
+  }
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    (void)buffer;
+    ++writes;
+    bytes += size;
+    return size;
+  }
+  using Print::write;
+};
+
+struct Group {
+  const char *name;
+  void (*fn)(void);
+  Group *next;
+
+  Group(const char *name, void (*fn)(void));
+};
+
+} // namespace bench
+
+#define BENCH_GROUP(name)                                                      \
+  static void bench_group_##name(void);                                        \
+  static bench::Group bench_group_registrar_##name{#name,                      \
+                                                   bench_group_##name};        \
+  static void bench_group_##name(void)
+
+#endif // _bench_h_
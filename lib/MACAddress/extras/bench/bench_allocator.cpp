@@ -0,0 +1,73 @@
+/*
+ *      @file: bench_allocator.cpp
+ *
+ * Sequential address generation: the lock-free allocator against a
+ * MACAddress shared under a mutex.
+ */
+
+#include "bench.h"
+
+#include <MACAddressAllocator.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const uint64_t _per_thread{1 << 16};
+static const unsigned _threads{4};
+
+template <typename F> static void _parallel(F f) {
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t != _threads; ++t)
+    workers.emplace_back(f);
+  for (auto &w : workers)
+    w.join();
+}
+
+BENCH_GROUP(allocator) {
+  const MAC48 base{0xCA, 0xFE, 0xBA, 0x00, 0x00, 0x00};
+
+  bench::run("MACAddressAllocator::allocate 1 thread", [&] {
+    MACAddressAllocator allocator{base, MA::S};
+    MAC48 mac;
+    for (uint64_t i = 0; i != _per_thread; ++i)
+      allocator.allocate(mac);
+    bench::keep(mac);
+  }, _per_thread);
+
+  bench::run("MACAddressAllocator::allocate 4 threads", [&] {
+    MACAddressAllocator allocator{base, MA::S};
+    _parallel([&] {
+      MAC48 mac;
+      for (uint64_t i = 0; i != _per_thread; ++i)
+        allocator.allocate(mac);
+      bench::keep(mac);
+    });
+  }, _per_thread * _threads);
+
+  bench::run("MACAddressAllocator leases of 1024, 4 threads", [&] {
+    MACAddressAllocator allocator{base, MA::S};
+    _parallel([&] {
+      MACAddressAllocator::Lease lease;
+      MAC48 mac;
+      for (uint64_t i = 0; i != _per_thread; ++i)
+        if (!lease.next(mac) && allocator.reserve(1024, lease))
+          lease.next(mac);
+      bench::keep(mac);
+    });
+  }, _per_thread * _threads);
+
+  bench::run("std::mutex + MACAddress::operator++, 4 threads", [&] {
+    MACAddress shared{base};
+    shared.ma = MA::S;
+    std::mutex mutex;
+    _parallel([&] {
+      MAC48 mac;
+      for (uint64_t i = 0; i != _per_thread; ++i) {
+        std::lock_guard<std::mutex> lock{mutex};
+        mac = (++shared).toMAC48();
+      }
+      bench::keep(mac);
+    });
+  }, _per_thread * _threads);
+}
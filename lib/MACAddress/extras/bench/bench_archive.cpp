@@ -0,0 +1,54 @@
+/*
+ *      @file: bench_archive.cpp
+ *
+ * Writing and reading back a 1M addresses inventory (a few dense OUIs) as a
+ * MACAddressArchive file, against the 18 bytes per address of a text list.
+ */
+
+#include "bench.h"
+
+#include <MACAddressArchive.h>
+
+#include <stdio.h>
+
+#include <vector>
+
+static const size_t _count{1 << 20};
+
+BENCH_GROUP(archive) {
+  const char *path = P_tmpdir "/macaddress_bench.mpk";
+
+  // 16 OUIs, one address out of 4 of their first 256K extension ids in use
+  std::vector<MAC48> macs(_count);
+  uint32_t seed{0x2545F491};
+  for (MAC48 &mac : macs) {
+    seed = seed * 1103515245 + 12345;
+    mac = MAC48{(0x0008A0ull + (seed >> 28)) << 24 | ((seed >> 8) & 0x3FFFF)};
+  }
+
+  bench::run("Writer::add", [&] {
+    MACAddressArchive::Writer writer;
+    writer.open(path);
+    for (MAC48 mac : macs)
+      writer.add(mac);
+    bench::keep(writer.close());
+  }, _count);
+
+  FILE *file = fopen(path, "rb");
+  if (file != nullptr) {
+    fseek(file, 0, SEEK_END);
+    bench::counter("archive size", static_cast<double>(ftell(file)) / _count,
+                   "bytes/address");
+    fclose(file);
+  }
+
+  std::vector<MAC48> out(4096);
+  bench::run("Reader::read", [&] {
+    MACAddressArchive::Reader reader;
+    reader.open(path);
+    while (reader.read(out.data(), out.size()) != 0)
+      bench::clobber();
+  }, _count);
+
+  remove(path);
+}
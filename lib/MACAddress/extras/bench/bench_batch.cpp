@@ -0,0 +1,119 @@
+/*
+ *      @file: bench_batch.cpp
+ *
+ * Bulk conversions of address lists against the one-address-at-a-time API.
+ */
+
+#include "bench.h"
+
+#include <MACAddress.h>
+#include <MACAddressBatch.h>
+
+#include <string>
+#include <vector>
+
+static const size_t _count{1 << 20};
+
+// Deterministic list of canonical addresses, one per line
+static std::string _list(char separator) {
+  std::string text;
+  uint64_t x{0x0123456789ABull};
+  text.reserve(_count * 18);
+
+  MACAddress mac;
+  for (size_t i = 0; i != _count; ++i) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    for (uint8_t j = 0; j != 6; ++j)
+      mac[j] = static_cast<uint8_t>(x >> (16 + 8 * j));
+    text += mac.c_str(separator == ':' ? Representation::COMMON_FULL
+                                       : Representation::EUI48);
+    text += '\n';
+  }
+
+  return text;
+}
+
+BENCH_GROUP(batch_parse) {
+  std::string colons = _list(':');
+  std::string dashes = _list('-');
+  std::vector<uint8_t> octets(_count * MACAddressBatch::octets_size);
+  std::vector<uint8_t> valid((_count + 7) / 8);
+
+  bench::run("MACAddressBatch::parse COMMON_FULL", [&] {
+    bench::keep(MACAddressBatch::parse(colons.data(), colons.size(),
+                                       octets.data(), valid.data(), _count));
+    bench::clobber();
+  }, _count);
+
+  bench::run("MACAddressBatch::parse EUI48", [&] {
+    bench::keep(MACAddressBatch::parse(dashes.data(), dashes.size(),
+                                       octets.data(), valid.data(), _count));
+    bench::clobber();
+  }, _count);
+
+  // the same list through MACAddress(const char[]), line by line
+  std::string lines = colons;
+  for (size_t i = 0; i != lines.size(); ++i)
+    if (lines[i] == '\n')
+      lines[i] = '\0';
+
+  bench::run("MACAddress(const char[]) loop", [&] {
+    const char *p = lines.data();
+    uint8_t *out = octets.data();
+    for (size_t i = 0; i != _count; ++i, p += 18, out += 6) {
+      MACAddress mac{p};
+      memcpy(out, static_cast<uint8_t *>(mac), 6);
+    }
+    bench::clobber();
+  }, _count);
+}
+
+BENCH_GROUP(batch_format) {
+  std::string colons = _list(':');
+  std::vector<uint8_t> octets(_count * MACAddressBatch::octets_size);
+  std::vector<uint8_t> valid((_count + 7) / 8);
+  MACAddressBatch::parse(colons.data(), colons.size(), octets.data(),
+                         valid.data(), _count);
+  std::vector<char> text(MACAddressBatch::formatSize(_count));
+
+  bench::run("MACAddressBatch::format COMMON_FULL", [&] {
+    bench::keep(MACAddressBatch::format(octets.data(), _count,
+                                        Representation::COMMON_FULL,
+                                        text.data()));
+    bench::clobber();
+  }, _count);
+
+  bench::run("MACAddressBatch::format EUI48", [&] {
+    bench::keep(MACAddressBatch::format(octets.data(), _count,
+                                        Representation::EUI48, text.data()));
+    bench::clobber();
+  }, _count);
+
+  bench::run("MACAddressBatch::format COMMON_COMPACT", [&] {
+    bench::keep(MACAddressBatch::format(octets.data(), _count,
+                                        Representation::COMMON_COMPACT,
+                                        text.data()));
+    bench::clobber();
+  }, _count);
+
+  // the same export through c_str(), address by address
+  const Representation representations[]{Representation::COMMON_FULL,
+                                         Representation::EUI48,
+                                         Representation::COMMON_COMPACT};
+  const char *names[]{"c_str loop COMMON_FULL", "c_str loop EUI48",
+                      "c_str loop COMMON_COMPACT"};
+  for (uint8_t r = 0; r != 3; ++r)
+    bench::run(names[r], [&] {
+      char *out = text.data();
+      const uint8_t *p = octets.data();
+      for (size_t i = 0; i != _count; ++i, p += 6) {
+        MACAddress mac{const_cast<uint8_t *>(p)};
+        const char *s = mac.c_str(representations[r]);
+        size_t length = strlen(s);
+        memcpy(out, s, length);
+        out[length] = '\n';
+        out += length + 1;
+      }
+      bench::clobber();
+    }, _count);
+}
@@ -0,0 +1,66 @@
+/*
+ *      @file: bench_capture.cpp
+ *
+ * Analysis of a generated pcap capture (1M frames of 60 to 1514 bytes
+ * between 20000 addresses).
+ */
+
+#include "bench.h"
+
+#include <MACAddressCapture.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+static const size_t _frames{1 << 20};
+
+static uint64_t _random(uint64_t &seed) {
+  seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+  return seed >> 16;
+}
+
+static void _pcap(const char *path) {
+  FILE *file = fopen(path, "wb");
+  const uint32_t header[6]{0xA1B2C3D4, 0x00040002, 0, 0, 65535, 1};
+  fwrite(header, sizeof(header), 1, file);
+
+  std::vector<uint64_t> addresses(20000);
+  uint64_t seed{1};
+  for (uint64_t &address : addresses)
+    address = _random(seed) & 0xFCFFFFFFFFFFull;
+
+  std::vector<uint8_t> frame(1514);
+  for (size_t i = 0; i != _frames; ++i) {
+    const uint32_t length = 60 + _random(seed) % (1514 - 60);
+    const uint32_t record[4]{0, 0, length, length};
+    MAC48{addresses[_random(seed) % addresses.size()]}.toOctets(&frame[0]);
+    MAC48{addresses[_random(seed) % addresses.size()]}.toOctets(&frame[6]);
+    fwrite(record, sizeof(record), 1, file);
+    fwrite(frame.data(), length, 1, file);
+  }
+  fclose(file);
+}
+
+BENCH_GROUP(capture) {
+  char path[] = "/tmp/macaddress_bench_pcapXXXXXX";
+  ::close(mkstemp(path));
+  _pcap(path);
+
+  MACAddressCapture capture;
+  capture.open(path);
+
+  bench::run("MACAddressCapture::analyze 1 thread", [&] {
+    bench::keep(capture.analyze(1));
+  }, _frames);
+
+  if (std::thread::hardware_concurrency() > 1)
+    bench::run("MACAddressCapture::analyze all threads", [&] {
+      bench::keep(capture.analyze());
+    }, _frames);
+
+  capture.close();
+  unlink(path);
+}
@@ -0,0 +1,63 @@
+/*
+ *      @file: bench_classifier.cpp
+ *
+ * Classifying addresses against an ACL of a few thousand OUI, MA-M, MA-S
+ * and bit rules. The baseline checks each rule in turn; the compiled
+ * classifier does one lookup per distinct mask.
+ */
+
+#include "bench.h"
+
+#include <MACAddressClassifier.h>
+
+#include <vector>
+
+static const size_t _rules{4000};
+static const size_t _entries{1 << 16};
+
+BENCH_GROUP(classifier) {
+  uint64_t seed{1};
+  auto random48 = [&] {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    return MAC48{seed >> 16};
+  };
+
+  // 3/4 of OUIs, then MA-M and MA-S blocks; the local bit rule comes last
+  std::vector<MACAddressPrefix> prefixes;
+  for (size_t i = 0; i != _rules; ++i)
+    prefixes.push_back(MACAddressPrefix::block(
+        random48(), i < _rules * 3 / 4 ? MA::L : i % 2 ? MA::M : MA::S));
+  prefixes.push_back(MACAddressPrefix::local());
+
+  MACAddressClassifier acl;
+  for (const MACAddressPrefix &prefix : prefixes)
+    acl.add(prefix);
+
+  // half of the addresses in a block of the ACL
+  std::vector<MAC48> macs(_entries);
+  for (size_t i = 0; i != _entries; ++i) {
+    macs[i] = random48();
+    if (i % 2)
+      macs[i] = MAC48{prefixes[i % _rules].value().value() |
+                      (macs[i].value() & ~prefixes[i % _rules].mask().value())};
+  }
+
+  size_t i{0};
+  bench::run("linear scan of the rules", [&] {
+    const MAC48 mac = macs[i++ % _entries];
+    uint32_t rule{0};
+    while (rule != prefixes.size() && !prefixes[rule].matches(mac))
+      ++rule;
+    bench::keep(rule);
+  });
+
+  bench::run("MACAddressClassifier::classify", [&] {
+    bench::keep(acl.classify(macs[i++ % _entries]));
+  });
+
+  std::vector<uint32_t> rules(_entries);
+  bench::run("MACAddressClassifier::classify(batch)", [&] {
+    acl.classify(macs.data(), _entries, rules.data());
+    bench::clobber();
+  }, _entries);
+}
@@ -0,0 +1,67 @@
+/*
+ *      @file: bench_derivation.cpp
+ *
+ * Deriving the addresses of a /16 from the IPv4 addresses of its hosts: one
+ * MACAddress at a time (the README pattern) against the batch derivation.
+ */
+
+#include "bench.h"
+
+#include <MACAddress.h>
+#include <MACAddressDerivation.h>
+
+#include <vector>
+
+static const uint32_t _first{MACAddressDerivation::ipv4(10, 1, 0, 0)};
+static const size_t _hosts{1 << 16};
+
+BENCH_GROUP(derivation) {
+  typedef MACAddressDerivation::Rule Rule;
+  const MAC48 base{0x00, 0x08, 0xAB, 0x00, 0x00, 0x00};
+  std::vector<uint8_t> octets(6 * _hosts);
+
+  bench::run("MACAddress mac[2 + i] = ip[i]", [&] {
+    MACAddress mac{base};
+    for (size_t h = 0; h != _hosts; ++h) {
+      const uint32_t ip = _first + static_cast<uint32_t>(h);
+      for (uint8_t i = 0; i != 4; ++i)
+        mac[2 + i] = static_cast<uint8_t>(ip >> (24 - 8 * i));
+      memcpy(&octets[6 * h], static_cast<uint8_t *>(mac), 6);
+    }
+    bench::clobber();
+  }, _hosts);
+
+  bench::run("MACAddressDerivation::derive(EMBED)", [&] {
+    bench::keep(MACAddressDerivation::derive(base, MA::L, Rule::EMBED, _first,
+                                             _hosts, octets.data()));
+    bench::clobber();
+  }, _hosts);
+
+  bench::run("MACAddressDerivation::derive(OFFSET)", [&] {
+    bench::keep(MACAddressDerivation::derive(base, MA::L, Rule::OFFSET,
+                                             _first, _hosts, octets.data()));
+    bench::clobber();
+  }, _hosts);
+
+  bench::run("MACAddressDerivation::forEach(OFFSET)", [&] {
+    uint64_t sum{0};
+    MACAddressDerivation::forEach(base, MA::L, Rule::OFFSET, _first, _hosts,
+                                  [&](uint32_t, MAC48 mac) {
+                                    sum += mac.value();
+                                    return true;
+                                  });
+    bench::keep(sum);
+  }, _hosts);
+
+  // one address out of 16 of the range already in use
+  MACAddressSet existing;
+  for (size_t h = 0; h < _hosts; h += 16)
+    existing.insert(MAC48{base.value() + h});
+  std::vector<uint8_t> found((_hosts + 7) / 8);
+  MACAddressDerivation::derive(base, MA::L, Rule::OFFSET, _first, _hosts,
+                               octets.data());
+  bench::run("MACAddressDerivation::collisions", [&] {
+    bench::keep(MACAddressDerivation::collisions(octets.data(), _hosts,
+                                                 existing, found.data()));
+  }, _hosts);
+}
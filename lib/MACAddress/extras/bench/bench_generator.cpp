@@ -0,0 +1,47 @@
+/*
+ *      @file: bench_generator.cpp
+ *
+ * Handing out 64K addresses from a MACAddressGenerator kept in a file (as
+ * the boards keep it in their EEPROM): a commit per address against ranges
+ * reserved ahead.
+ */
+
+#include "bench.h"
+
+#include <MACAddressGenerator.h>
+
+#include <stdio.h>
+
+static const size_t _count{1 << 16};
+
+BENCH_GROUP(generator) {
+  const char *path = P_tmpdir "/macaddress_bench.eeprom";
+  const MAC48 base{0x00, 0x08, 0xAB, 0x00, 0x00, 0x00};
+  const uint32_t reserves[]{1, 16, 256};
+
+  for (uint32_t reserve : reserves) {
+    char name[48];
+    snprintf(name, sizeof(name), "next, reserve %u", reserve);
+
+    MACAddressFileStorage storage;
+    unsigned long writes{0};
+    bench::run(name, [&] {
+      remove(path);
+      storage.open(path, 1024);
+      MACAddressGenerator generator{storage, base, MA::L, reserve};
+      generator.begin();
+      MAC48 mac;
+      for (size_t i = 0; i != _count; ++i)
+        generator.next(mac);
+      bench::keep(mac);
+      writes = storage.writes();
+      storage.close();
+    }, _count);
+
+    snprintf(name, sizeof(name), "storage writes, reserve %u", reserve);
+    bench::counter(name, static_cast<double>(_count) / writes,
+                   "addresses/write");
+  }
+
+  remove(path);
+}
@@ -0,0 +1,230 @@
+/*
+ *      @file: bench_macaddress.cpp
+ *
+ * Baseline of the MACAddress class hot paths: parsing, formatting, printing,
+ * extension id arithmetic and comparison against strings.
+ */
+
+#include "bench.h"
+
+#include <MACAddress.h>
+
+// Exposes the protected hot paths to the benchmarks.
+class MACAddressProbe : public MACAddress {
+public:
+  using MACAddress::_fromString;
+  using MACAddress::_sum;
+};
+
+BENCH_GROUP(parse) {
+  MACAddressProbe mac;
+
+  char full[]{"AB:CD:EF:01:23:45"};
+  bench::run("_fromString COMMON_FULL", [&] {
+    bench::keep(mac._fromString(full));
+  });
+
+  char eui48[]{"AB-CD-EF-01-23-45"};
+  bench::run("_fromString EUI48", [&] {
+    bench::keep(mac._fromString(eui48));
+  });
+
+  char compact[]{"8::12:34:56:78"};
+  bench::run("_fromString COMMON_COMPACT", [&] {
+    bench::keep(mac._fromString(compact));
+  });
+
+  char invalid[]{"AB:CD:EF:01:23:4G"};
+  bench::run("_fromString invalid", [&] {
+    bench::keep(mac._fromString(invalid));
+  });
+
+  bench::run("fromString(const char[])", [&] {
+    bench::keep(mac.fromString("AB:CD:EF:01:23:45"));
+  });
+
+  bench::run("fromString(F())", [&] {
+    bench::keep(mac.fromString(F("AB:CD:EF:01:23:45")));
+  });
+
+  String s{"AB:CD:EF:01:23:45"};
+  bench::run("fromString(String)", [&] { bench::keep(mac.fromString(s)); });
+
+  bench::run("MACAddress(F()) constant", [&] {
+    MACAddress constant{F("0:8:ab:cd:0:3")};
+    bench::keep(constant[5]);
+  });
+
+  bench::run("MACAddress(\"...\"_mac) constant", [&] {
+    MACAddress constant{"0:8:ab:cd:0:3"_mac};
+    bench::keep(constant[5]);
+  });
+
+  static const char slice[]{"AB:CD:EF:01:23:45\",\"0019.e8a2.0c41\","
+                            "\"0019E8A20C41\""};
+  Notation notation;
+  bench::run("parse(buffer, length) COLON", [&] {
+    bench::keep(mac.parse(slice, 17, &notation));
+  });
+  bench::run("parse(buffer, length) DOTTED", [&] {
+    bench::keep(mac.parse(slice + 20, 14, &notation));
+  });
+  bench::run("parse(buffer, length) BARE", [&] {
+    bench::keep(mac.parse(slice + 37, 12, &notation));
+  });
+}
+
+BENCH_GROUP(format) {
+  MACAddress mac{0x0A, 0xBC, 0x00, 0x01, 0x23, 0xF0};
+
+  bench::run("c_str COMMON_FULL", [&] {
+    bench::keep(mac.c_str(Representation::COMMON_FULL));
+  });
+  bench::run("c_str EUI48", [&] {
+    bench::keep(mac.c_str(Representation::EUI48));
+  });
+  bench::run("c_str COMMON_COMPACT", [&] {
+    bench::keep(mac.c_str(Representation::COMMON_COMPACT));
+  });
+
+  // compact octets of every width (zeroed, one digit, two digits) in an order
+  // the branch predictor cannot learn
+  static uint8_t mixed[4096][6];
+  uint32_t seed{0x12345678};
+  for (auto &octets : mixed)
+    for (auto &octet : octets) {
+      seed = seed * 1103515245 + 12345;
+      const uint8_t width = (seed >> 16) % 3;
+      octet = width == 0 ? 0 : (seed >> 8) & (width == 1 ? 0x0F : 0xFF);
+    }
+  char compact[MACAddressFormat::size];
+  uint16_t next{0};
+  bench::run("write COMMON_COMPACT mixed", [&] {
+    bench::keep(MACAddressFormat::write(compact, mixed[next++ & 4095],
+                                        Representation::COMMON_COMPACT));
+    bench::clobber();
+  });
+
+  char text[MACAddressFormat::size];
+  bench::run("toChars COMMON_FULL", [&] {
+    bench::keep(mac.toChars(text, text + sizeof(text)));
+    bench::clobber();
+  });
+  bench::run("uint64ToHex", [&] {
+    bench::clobber();
+    bench::keep(mac.uint64ToHex(mac.getExtensionId36()));
+  });
+
+  bench::NullPrint sink;
+  bench::run("printTo", [&] { bench::keep(mac.printTo(sink)); });
+  sink.writes = 0;
+  mac.printTo(sink);
+  bench::counter("printTo writes", sink.writes, "writes/op");
+
+  bench::run("print(as(EUI48))", [&] {
+    bench::keep(sink.print(mac.as(Representation::EUI48)));
+  });
+}
+
+BENCH_GROUP(arithmetic) {
+  MACAddressProbe mac;
+
+  mac.ma = MA::L;
+  bench::run("_sum MA::L", [&] { bench::keep(mac._sum(0x10001, true)); });
+  mac.ma = MA::M;
+  bench::run("_sum MA::M", [&] { bench::keep(mac._sum(0x10001, true)); });
+  mac.ma = MA::S;
+  bench::run("_sum MA::S", [&] { bench::keep(mac._sum(0x10001, true)); });
+
+  mac.ma = MA::L;
+  bench::run("operator++", [&] { bench::keep(++mac); });
+}
+
+BENCH_GROUP(compare) {
+  MACAddress mac{0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+  MACAddress other{0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+
+  bench::run("operator==(const MACAddress &)", [&] {
+    bench::keep(mac == other);
+  });
+
+  char address[]{"AB:CD:EF:01:23:45"};
+  bench::run("operator==(char *)", [&] {
+    bench::keep(mac == address);
+  });
+
+  const char *caddress{"AB:CD:EF:01:23:45"};
+  bench::run("operator==(const char *)", [&] {
+    bench::keep(mac == caddress);
+  });
+
+  bench::run("operator==(F())", [&] {
+    bench::keep(mac == F("AB:CD:EF:01:23:45"));
+  });
+
+  String s{"AB:CD:EF:01:23:45"};
+  bench::run("operator==(String)", [&] { bench::keep(mac == s); });
+
+  const char *mismatch{"00:CD:EF:01:23:45"};
+  bench::run("operator==(const char *) mismatch", [&] {
+    bench::keep(mac == mismatch);
+  });
+}
+
+BENCH_GROUP(accessors) {
+  MACAddress mac{0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+  MAC48 packed = mac.toMAC48();
+  uint32_t n{0};
+
+  bench::run("MACAddress::getOUI24", [&] {
+    bench::clobber();
+    bench::keep(mac.getOUI24());
+  });
+  bench::run("MACAddress::getExtensionId36", [&] {
+    bench::clobber();
+    bench::keep(mac.getExtensionId36());
+  });
+  bench::run("MACAddress::setExtensionId28", [&] {
+    mac.setExtensionId28(++n);
+    bench::clobber();
+  });
+
+  bench::run("MAC48::getOUI24", [&] {
+    bench::keep(packed);
+    bench::keep(packed.getOUI24());
+  });
+  bench::run("MAC48::getExtensionId36", [&] {
+    bench::keep(packed);
+    bench::keep(packed.getExtensionId36());
+  });
+  bench::run("MAC48::setExtensionId28", [&] {
+    packed.setExtensionId28(++n);
+    bench::keep(packed);
+  });
+}
+
+BENCH_GROUP(view) {
+  static const size_t frames{1 << 14};
+  static const size_t frame_size{64};
+  static uint8_t buffer[frames * frame_size];
+  uint64_t seed{1};
+  for (uint8_t &octet : buffer) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    octet = static_cast<uint8_t>(seed >> 60); // few distinct addresses
+  }
+  const MACAddress gateway{MAC48::fromOctets(buffer + 6)};
+
+  bench::run("filter MACAddress{frame + 6}", [&] {
+    size_t matches{0};
+    for (size_t i = 0; i != frames; ++i)
+      matches += gateway == MACAddress{buffer + i * frame_size + 6};
+    bench::keep(matches);
+  }, frames);
+
+  bench::run("filter MACAddressView{frame + 6}", [&] {
+    size_t matches{0};
+    for (size_t i = 0; i != frames; ++i)
+      matches += gateway == MACAddressView{buffer + i * frame_size + 6};
+    bench::keep(matches);
+  }, frames);
+}
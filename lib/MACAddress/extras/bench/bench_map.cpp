@@ -0,0 +1,104 @@
+/*
+ *      @file: bench_map.cpp
+ *
+ * Flat hash maps keyed by MAC48 against std::unordered_map<uint64_t, V>.
+ */
+
+#include "bench.h"
+
+#include <MACAddressMap.h>
+
+#include <unordered_map>
+#include <vector>
+
+static const size_t _entries{1 << 20};
+
+// Half of the keys are sequential in a block, half are random
+static std::vector<uint64_t> _keys(uint64_t seed) {
+  std::vector<uint64_t> keys(_entries);
+  for (size_t i = 0; i != _entries; ++i) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    keys[i] = (i & 1) ? (seed >> 16) : (0x0008AB000000ull + i);
+  }
+  return keys;
+}
+
+BENCH_GROUP(map) {
+  const std::vector<uint64_t> keys = _keys(1);
+  const std::vector<uint64_t> missing = _keys(2);
+
+  bench::run("MACAddressMap::insert", [&] {
+    MACAddressMap<uint32_t> map;
+    for (size_t i = 0; i != _entries; ++i)
+      map.insert(MAC48{keys[i]}, static_cast<uint32_t>(i));
+    bench::keep(map.size());
+  }, _entries);
+
+  bench::run("std::unordered_map::insert", [&] {
+    std::unordered_map<uint64_t, uint32_t> map;
+    for (size_t i = 0; i != _entries; ++i)
+      map[keys[i]] = static_cast<uint32_t>(i);
+    bench::keep(map.size());
+  }, _entries);
+
+  MACAddressMap<uint32_t> map;
+  std::unordered_map<uint64_t, uint32_t> std_map;
+  for (size_t i = 0; i != _entries; ++i) {
+    map.insert(MAC48{keys[i]}, static_cast<uint32_t>(i));
+    std_map[keys[i]] = static_cast<uint32_t>(i);
+  }
+
+  bench::run("MACAddressMap::find hit", [&] {
+    uint32_t sum{0};
+    for (size_t i = 0; i != _entries; ++i)
+      sum += *map.find(MAC48{keys[i]});
+    bench::keep(sum);
+  }, _entries);
+
+  bench::run("std::unordered_map::find hit", [&] {
+    uint32_t sum{0};
+    for (size_t i = 0; i != _entries; ++i)
+      sum += std_map.find(keys[i])->second;
+    bench::keep(sum);
+  }, _entries);
+
+  bench::run("MACAddressMap::find miss", [&] {
+    size_t found{0};
+    for (size_t i = 0; i != _entries; ++i)
+      found += map.find(MAC48{missing[i]}) != nullptr;
+    bench::keep(found);
+  }, _entries);
+
+  bench::run("std::unordered_map::find miss", [&] {
+    size_t found{0};
+    for (size_t i = 0; i != _entries; ++i)
+      found += std_map.find(missing[i]) != std_map.end();
+    bench::keep(found);
+  }, _entries);
+
+  bench::run("MACAddressMap::erase + insert", [&] {
+    for (size_t i = 0; i != _entries; ++i) {
+      map.erase(MAC48{keys[i]});
+      map.insert(MAC48{keys[i]}, static_cast<uint32_t>(i));
+    }
+    bench::keep(map.size());
+  }, _entries);
+
+  bench::run("std::unordered_map::erase + insert", [&] {
+    for (size_t i = 0; i != _entries; ++i) {
+      std_map.erase(keys[i]);
+      std_map[keys[i]] = static_cast<uint32_t>(i);
+    }
+    bench::keep(std_map.size());
+  }, _entries);
+
+  bench::run("MACAddressFixedMap<uint16_t, 512> insert + find", [&] {
+    MACAddressFixedMap<uint16_t, 512> fixed;
+    uint32_t sum{0};
+    for (size_t i = 0; i != fixed.capacity(); ++i)
+      fixed.insert(MAC48{keys[i]}, static_cast<uint16_t>(i));
+    for (size_t i = 0; i != fixed.capacity(); ++i)
+      sum += *fixed.find(MAC48{keys[i]});
+    bench::keep(sum);
+  }, MACAddressFixedMap<uint16_t, 512>::capacity());
+}
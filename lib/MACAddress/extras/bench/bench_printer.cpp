@@ -0,0 +1,59 @@
+/*
+ *      @file: bench_printer.cpp
+ *
+ * Streaming many addresses into a Print sink: one printTo/println per address
+ * against the buffering MACAddressPrinter.
+ */
+
+#include "bench.h"
+
+#include <MACAddressBatch.h>
+#include <MACAddressPrinter.h>
+
+#include <vector>
+
+static const size_t _entries{1 << 16};
+
+BENCH_GROUP(printer) {
+  std::vector<uint8_t> octets(MACAddressBatch::octets_size * _entries);
+  uint64_t seed{1};
+  for (uint8_t &octet : octets) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    octet = static_cast<uint8_t>(seed >> 56);
+  }
+
+  bench::NullPrint sink;
+  auto writes = [&](const char *name, size_t (*stream)(Print &,
+                                                       const uint8_t *)) {
+    bench::run(name, [&] { bench::keep(stream(sink, octets.data())); },
+               _entries);
+    sink.writes = 0;
+    stream(sink, octets.data());
+    bench::counter(name, static_cast<double>(sink.writes) / _entries,
+                   "writes/address");
+  };
+
+  writes("println(MACAddress)", [](Print &p, const uint8_t *octets) {
+    size_t n{0};
+    for (size_t i = 0; i != _entries; ++i)
+      n += p.println(MACAddress{
+          MAC48::fromOctets(octets + MACAddressBatch::octets_size * i)});
+    return n;
+  });
+
+  writes("MACAddressPrinter::print(MAC48)", [](Print &p,
+                                                const uint8_t *octets) {
+    MACAddressPrinter printer{p};
+    size_t n{0};
+    for (size_t i = 0; i != _entries; ++i)
+      n += printer.print(
+          MAC48::fromOctets(octets + MACAddressBatch::octets_size * i));
+    return n + printer.flush();
+  });
+
+  writes("MACAddressPrinter::print(packed)", [](Print &p,
+                                                 const uint8_t *octets) {
+    MACAddressPrinter printer{p};
+    return printer.print(octets, _entries) + printer.flush();
+  });
+}
@@ -0,0 +1,53 @@
+/*
+ *      @file: bench_random.cpp
+ *
+ * Generating 64K unique random addresses: locally administered unicast ones
+ * and ones confined to an OUI, as MAC48 values or packed octets.
+ */
+
+#include "bench.h"
+
+#include <MACAddressRandom.h>
+
+#include <vector>
+
+static const size_t _count{1 << 16};
+
+BENCH_GROUP(random) {
+  std::vector<MAC48> macs(_count);
+  std::vector<uint8_t> octets(6 * _count);
+
+  MACAddressRandom local{0x5EED};
+  bench::run("generate(MAC48) local", [&] {
+    if (local.remaining() < _count)
+      local = MACAddressRandom{0x5EED};
+    bench::keep(local.generate(macs.data(), _count));
+    bench::clobber();
+  }, _count);
+
+  bench::run("generate(octets) local", [&] {
+    if (local.remaining() < _count)
+      local = MACAddressRandom{0x5EED};
+    bench::keep(local.generate(octets.data(), _count));
+    bench::clobber();
+  }, _count);
+
+  // 2^24 addresses: the space is started over when exhausted
+  const MACAddressPrefix oui{MAC48{0x0A, 0x1B, 0x2C, 0, 0, 0}, 24};
+  MACAddressRandom vendor{0x5EED, oui};
+  bench::run("generate(MAC48) OUI", [&] {
+    if (vendor.remaining() < _count)
+      vendor = MACAddressRandom{0x5EED, oui};
+    bench::keep(vendor.generate(macs.data(), _count));
+    bench::clobber();
+  }, _count);
+
+  bench::run("next(MAC48) OUI", [&] {
+    if (vendor.remaining() < _count)
+      vendor = MACAddressRandom{0x5EED, oui};
+    MAC48 mac;
+    for (size_t i = 0; i != _count; ++i)
+      vendor.next(mac);
+    bench::keep(mac);
+  }, _count);
+}
@@ -0,0 +1,57 @@
+/*
+ *      @file: bench_range.cpp
+ *
+ * Walking 64K consecutive addresses of an MA-M block: ++ on a MACAddress
+ * against a MACAddressRange, iterated or filled at once.
+ */
+
+#include "bench.h"
+
+#include <MACAddress.h>
+#include <MACAddressRange.h>
+
+#include <vector>
+
+static const size_t _count{1 << 16};
+
+BENCH_GROUP(range) {
+  // close to the end of the block: the range wraps around
+  const MAC48 first{0x00, 0x08, 0xAB, 0xCF, 0xFF, 0x00};
+  const MACAddressRange range{first, _count, MA::M};
+  std::vector<uint8_t> octets(6 * _count);
+  std::vector<MAC48> macs(_count);
+
+  bench::run("MACAddress ++", [&] {
+    MACAddress mac{first};
+    mac.ma = MA::M;
+    for (size_t i = 0; i != _count; ++i, ++mac)
+      memcpy(&octets[6 * i], static_cast<uint8_t *>(mac), 6);
+    bench::clobber();
+  }, _count);
+
+  bench::run("MACAddressRange for", [&] {
+    uint8_t *out = octets.data();
+    for (MAC48 mac : range) {
+      mac.toOctets(out);
+      out += 6;
+    }
+    bench::clobber();
+  }, _count);
+
+  bench::run("MACAddressRange begin() + k", [&] {
+    uint64_t sum{0};
+    for (size_t k = 0; k < _count; k += 7)
+      sum += (*(range.begin() + static_cast<int64_t>(k))).value();
+    bench::keep(sum);
+  }, (_count + 6) / 7);
+
+  bench::run("MACAddressRange::fill(octets)", [&] {
+    bench::keep(range.fill(octets.data()));
+    bench::clobber();
+  }, _count);
+
+  bench::run("MACAddressRange::fill(MAC48)", [&] {
+    bench::keep(range.fill(macs.data()));
+    bench::clobber();
+  }, _count);
+}
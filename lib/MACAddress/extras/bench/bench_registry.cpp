@@ -0,0 +1,98 @@
+/*
+ *      @file: bench_registry.cpp
+ *
+ * Vendor lookups in a registry compiled from a synthetic CSV of the size of
+ * the IEEE one (about 38000 MA-L, 6000 MA-M and 7000 MA-S assignments).
+ */
+
+#include "bench.h"
+
+#include <MACAddressRegistry.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <vector>
+
+static const size_t _lookups{1 << 16};
+
+static uint64_t _random(uint64_t &seed) {
+  seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+  return seed >> 16;
+}
+
+// Writes the CSV to path and returns the assigned OUIs
+static std::vector<uint64_t> _csv(const char *path) {
+  std::vector<uint64_t> ouis;
+  FILE *file = fopen(path, "w");
+  fprintf(file, "Registry,Assignment,Organization Name,Organization Address\n");
+
+  uint64_t seed{1};
+  for (size_t i = 0; i != 38000; ++i) {
+    const uint64_t oui = _random(seed) & 0xFCFFFF; // globally unique unicast
+    ouis.push_back(oui);
+    fprintf(file, "MA-L,%06llX,\"Vendor %zu, Inc.\",\"Street %zu\"\n",
+            static_cast<unsigned long long>(oui), i, i);
+  }
+  for (size_t i = 0; i != 6000; ++i)
+    fprintf(file, "MA-M,%06llX%01X,Vendor M%zu,Street\n",
+            static_cast<unsigned long long>(ouis[i % 8]),
+            static_cast<unsigned>(i & 0xF), i);
+  for (size_t i = 0; i != 7000; ++i)
+    fprintf(file, "MA-S,%06llX%03X,Vendor S%zu,Street\n",
+            static_cast<unsigned long long>(ouis[8 + i % 4]),
+            static_cast<unsigned>(i & 0xFFF), i);
+
+  fclose(file);
+  return ouis;
+}
+
+BENCH_GROUP(registry) {
+  char csv[] = "/tmp/macaddress_bench_csvXXXXXX";
+  char bin[] = "/tmp/macaddress_bench_binXXXXXX";
+  ::close(mkstemp(csv));
+  ::close(mkstemp(bin));
+
+  const std::vector<uint64_t> ouis = _csv(csv);
+  const char *csvs[]{csv};
+
+  bench::run("MACAddressRegistry::compile", [&] {
+    bench::keep(MACAddressRegistry::compile(csvs, 1, bin));
+  });
+
+  MACAddressRegistry registry;
+  MACAddressRegistry::compile(csvs, 1, bin);
+  registry.open(bin);
+
+  std::vector<MAC48> flat(_lookups), nested(_lookups);
+  uint64_t seed{2};
+  for (size_t i = 0; i != _lookups; ++i) {
+    const uint64_t oui = ouis[12 + _random(seed) % (ouis.size() - 12)];
+    flat[i] = MAC48{oui << 24 | (_random(seed) & 0xFFFFFF)};
+    nested[i] = MAC48{ouis[_random(seed) % 12] << 24 |
+                      (_random(seed) & 0xFFFFFF)};
+  }
+
+  bench::run("MACAddressRegistry::open", [&] {
+    MACAddressRegistry r;
+    bench::keep(r.open(bin));
+  });
+
+  bench::run("MACAddressRegistry::lookup MA-L", [&] {
+    size_t found{0};
+    for (size_t i = 0; i != _lookups; ++i)
+      found += registry.lookup(flat[i]) != nullptr;
+    bench::keep(found);
+  }, _lookups);
+
+  bench::run("MACAddressRegistry::lookup MA-M/MA-S", [&] {
+    size_t found{0};
+    for (size_t i = 0; i != _lookups; ++i)
+      found += registry.lookup(nested[i]) != nullptr;
+    bench::keep(found);
+  }, _lookups);
+
+  registry.close();
+  unlink(csv);
+  unlink(bin);
+}
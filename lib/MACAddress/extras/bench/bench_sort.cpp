@@ -0,0 +1,83 @@
+/*
+ *      @file: bench_sort.cpp
+ *
+ * Radix sort and set operations on large arrays against std::sort and the
+ * std:: set algorithms.
+ */
+
+#include "bench.h"
+
+#include <MACAddressSort.h>
+
+#include <algorithm>
+#include <vector>
+
+static const size_t _entries{1 << 22};
+
+// Random addresses, a quarter of them under a few OUIs
+static std::vector<MAC48> _values(uint64_t seed) {
+  std::vector<MAC48> values(_entries);
+  for (size_t i = 0; i != _entries; ++i) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    values[i] = MAC48{(i & 3) ? (seed >> 16)
+                              : (0x0008AB000000ull << (seed & 3)) ^
+                                    (seed >> 40)};
+  }
+  return values;
+}
+
+BENCH_GROUP(sort) {
+  const std::vector<MAC48> input = _values(1);
+  std::vector<MAC48> values(_entries), scratch(_entries);
+
+  std::vector<uint8_t> packed_input(6 * _entries), packed(6 * _entries),
+      packed_scratch(6 * _entries);
+  for (size_t i = 0; i != _entries; ++i)
+    input[i].toOctets(&packed_input[6 * i]);
+
+  bench::run("MACAddressSort::sort MAC48", [&] {
+    values = input;
+    MACAddressSort::sort(values.data(), _entries, scratch.data());
+    bench::keep(values[0]);
+  }, _entries);
+
+  bench::run("MACAddressSort::sort packed", [&] {
+    packed = packed_input;
+    MACAddressSort::sort(packed.data(), _entries, packed_scratch.data());
+    bench::keep(packed[0]);
+  }, _entries);
+
+#ifdef MACADDRESS_HAS_THREAD
+  bench::run("MACAddressSort::sortParallel MAC48", [&] {
+    values = input;
+    MACAddressSort::sortParallel(values.data(), _entries, scratch.data());
+    bench::keep(values[0]);
+  }, _entries);
+#endif
+
+  bench::run("std::sort MAC48", [&] {
+    values = input;
+    std::sort(values.begin(), values.end());
+    bench::keep(values[0]);
+  }, _entries);
+
+  std::vector<MAC48> a = input, b = _values(2);
+  MACAddressSort::sort(a.data(), _entries, scratch.data());
+  MACAddressSort::sort(b.data(), _entries, scratch.data());
+  std::vector<MAC48> out(_entries);
+
+  bench::run("MACAddressSort::unique", [&] {
+    values = a;
+    bench::keep(MACAddressSort::unique(values.data(), _entries));
+  }, _entries);
+
+  bench::run("MACAddressSort::difference", [&] {
+    bench::keep(MACAddressSort::difference(a.data(), _entries, b.data(),
+                                           _entries, out.data()));
+  }, 2 * _entries);
+
+  bench::run("std::set_difference", [&] {
+    bench::keep(std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                    out.begin()));
+  }, 2 * _entries);
+}
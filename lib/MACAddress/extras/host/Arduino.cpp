@@ -0,0 +1,211 @@
+/*
+ *      @file: Arduino.cpp
+ *
+ * Implementation of the host Arduino compatibility layer (see Arduino.h).
+ */
+
+#include "Arduino.h"
+
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c) {
+  return 1 == fwrite(&c, 1, 1, stdout) ? 1 : 0;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+static std::chrono::steady_clock::time_point _boot{
+    std::chrono::steady_clock::now()};
+
+unsigned long millis(void) {
+  return static_cast<unsigned long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - _boot)
+          .count());
+}
+
+unsigned long micros(void) {
+  return static_cast<unsigned long>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - _boot)
+          .count());
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Print
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n{0};
+  while (size--) {
+    if (write(*buffer++))
+      ++n;
+    else
+      break;
+  }
+  return n;
+}
+
+size_t Print::write(const char *str) {
+  if (str == nullptr)
+    return 0;
+  return write(str, strlen(str));
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  *str = '\0';
+
+  if (base < 2)
+    base = 10;
+
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+
+  return write(str);
+}
+
+size_t Print::print(const __FlashStringHelper *s) {
+  return write(reinterpret_cast<const char *>(s));
+}
+
+size_t Print::print(const String &s) { return write(s.c_str(), s.length()); }
+
+size_t Print::print(const char s[]) { return write(s); }
+
+size_t Print::print(char c) { return write(static_cast<uint8_t>(c)); }
+
+size_t Print::print(unsigned char n, int base) {
+  return print(static_cast<unsigned long>(n), base);
+}
+
+size_t Print::print(int n, int base) { return print(static_cast<long>(n), base); }
+
+size_t Print::print(unsigned int n, int base) {
+  return print(static_cast<unsigned long>(n), base);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == 0)
+    return write(static_cast<uint8_t>(n));
+
+  if (base == 10 && n < 0) {
+    size_t t = print('-');
+    return printNumber(-static_cast<unsigned long>(n), 10) + t;
+  }
+
+  return printNumber(static_cast<unsigned long>(n), base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  if (base == 0)
+    return write(static_cast<uint8_t>(n));
+  return printNumber(n, base);
+}
+
+size_t Print::print(const Printable &x) { return x.printTo(*this); }
+
+size_t Print::println(void) { return write("\r\n"); }
+
+size_t Print::println(const __FlashStringHelper *s) {
+  return print(s) + println();
+}
+
+size_t Print::println(const String &s) { return print(s) + println(); }
+
+size_t Print::println(const char s[]) { return print(s) + println(); }
+
+size_t Print::println(char c) { return print(c) + println(); }
+
+size_t Print::println(unsigned char n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned int n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+
+size_t Print::println(unsigned long n, int base) {
+  return print(n, base) + println();
+}
+
+size_t Print::println(const Printable &x) { return print(x) + println(); }
+
+// String
+
+void String::_assign(const char *cstr, size_t length) {
+  char *buffer = new char[length + 1];
+  memcpy(buffer, cstr, length);
+  buffer[length] = '\0';
+
+  delete[] _buffer;
+  _buffer = buffer;
+  _length = length;
+}
+
+String::String(const char *cstr) { _assign(cstr, strlen(cstr)); }
+
+String::String(const __FlashStringHelper *str) {
+  const char *cstr = reinterpret_cast<const char *>(str);
+  _assign(cstr, strlen(cstr));
+}
+
+String::String(const String &str) { _assign(str._buffer, str._length); }
+
+String::~String(void) { delete[] _buffer; }
+
+String &String::operator=(const String &rhs) {
+  if (this != &rhs)
+    _assign(rhs._buffer, rhs._length);
+  return *this;
+}
+
+String &String::operator=(const char *cstr) {
+  _assign(cstr, strlen(cstr));
+  return *this;
+}
+
+String &String::operator+=(const String &rhs) {
+  return operator+=(rhs.c_str());
+}
+
+String &String::operator+=(const char *cstr) {
+  size_t length = strlen(cstr);
+  char *buffer = new char[_length + length + 1];
+  memcpy(buffer, _buffer, _length);
+  memcpy(buffer + _length, cstr, length + 1);
+
+  delete[] _buffer;
+  _buffer = buffer;
+  _length += length;
+  return *this;
+}
+
+String &String::operator+=(char c) {
+  char s[2]{c, '\0'};
+  return operator+=(s);
+}
+
+bool String::operator==(const String &rhs) const {
+  return _length == rhs._length && 0 == memcmp(_buffer, rhs._buffer, _length);
+}
+
+bool String::operator==(const char *cstr) const {
+  return 0 == strcmp(_buffer, cstr);
+}
@@ -0,0 +1,66 @@
+#ifndef _Arduino_h_
+#define _Arduino_h_
+
+/*
+ *      @file: Arduino.h
+ *
+ * Minimal Arduino compatibility layer used to build the MACAddress library on
+ * a Linux host (provisioning servers, benchmarks).
+ *
+ * Only the small subset of the core the library depends on is provided:
+ *   - Print / Printable (see Print.h)
+ *   - String and __FlashStringHelper (see WString.h)
+ *   - the avr/pgmspace helpers (PROGMEM, PGM_P, F(), pgm_read_*, *_P)
+ *   - Serial (writes to stdout), millis(), micros() and delay()
+ *
+ * Program memory does not exist on the host, so every "flash" pointer is a
+ * plain pointer into RAM.
+ */
+
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+typedef const char *PGM_P;
+
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t *>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t *>(addr))
+
+#define strcpy_P(dest, src) strcpy((dest), (src))
+#define strncpy_P(dest, src, n) strncpy((dest), (src), (n))
+#define strlen_P(s) strlen((s))
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#include "Print.h"
+#include "WString.h"
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+
+#endif // _Arduino_h_
@@ -0,0 +1,60 @@
+#ifndef _Print_h_
+#define _Print_h_
+
+/*
+ *      @file: Print.h
+ *
+ * Host replacement of the Arduino Print and Printable classes (see Arduino.h).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+class __FlashStringHelper;
+class String;
+class Print;
+
+class Printable {
+public:
+  virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+private:
+  size_t printNumber(unsigned long n, uint8_t base);
+
+public:
+  virtual ~Print(void) {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str);
+  size_t write(const char *buffer, size_t size) {
+    return write(reinterpret_cast<const uint8_t *>(buffer), size);
+  }
+
+  size_t print(const __FlashStringHelper *s);
+  size_t print(const String &s);
+  size_t print(const char s[]);
+  size_t print(char c);
+  size_t print(unsigned char n, int base = DEC);
+  size_t print(int n, int base = DEC);
+  size_t print(unsigned int n, int base = DEC);
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(const Printable &x);
+
+  size_t println(void);
+  size_t println(const __FlashStringHelper *s);
+  size_t println(const String &s);
+  size_t println(const char s[]);
+  size_t println(char c);
+  size_t println(unsigned char n, int base = DEC);
+  size_t println(int n, int base = DEC);
+  size_t println(unsigned int n, int base = DEC);
+  size_t println(long n, int base = DEC);
+  size_t println(unsigned long n, int base = DEC);
+  size_t println(const Printable &x);
+};
+
+#endif // _Print_h_
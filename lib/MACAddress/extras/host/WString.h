@@ -0,0 +1,51 @@
+#ifndef _WString_h_
+#define _WString_h_
+
+/*
+ *      @file: WString.h
+ *
+ * Host replacement of the Arduino String class (see Arduino.h).
+ *
+ * The buffer is managed through new[] / delete[] so that heap usage shows up
+ * in the allocation counters of the benchmarks.
+ */
+
+#include <stddef.h>
+
+class __FlashStringHelper;
+#define F(string_literal)                                                      \
+  (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+class String {
+private:
+  char *_buffer{nullptr};
+  size_t _length{0};
+
+  void _assign(const char *cstr, size_t length);
+
+public:
+  String(const char *cstr = "");
+  String(const __FlashStringHelper *str);
+  String(const String &str);
+  ~String(void);
+
+  String &operator=(const String &rhs);
+  String &operator=(const char *cstr);
+
+  String &operator+=(const String &rhs);
+  String &operator+=(const char *cstr);
+  String &operator+=(char c);
+
+  bool operator==(const String &rhs) const;
+  bool operator==(const char *cstr) const;
+  bool operator!=(const String &rhs) const { return !(*this == rhs); }
+  bool operator!=(const char *cstr) const { return !(*this == cstr); }
+
+  char operator[](size_t index) const { return _buffer[index]; }
+  char charAt(size_t index) const { return _buffer[index]; }
+
+  size_t length(void) const { return _length; }
+  const char *c_str(void) const { return _buffer; }
+};
+
+#endif // _WString_h_
@@ -0,0 +1,68 @@
+/*
+ *      @file: test.cpp
+ *
+ * Harness implementation and entry point of the MACAddress tests.
+ */
+
+#include "test.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <deque>
+
+namespace test {
+
+static Group *_groups{nullptr};
+static unsigned long _checks{0};
+static unsigned long _failures{0};
+// a deque: the paths handed out stay valid as more are added
+static std::deque<std::string> _paths;
+
+void check(bool ok, const char *expression, const char *file, int line) {
+  ++_checks;
+  if (ok)
+    return;
+
+  ++_failures;
+  printf("  FAILED %s:%d: %s\n", file, line, expression);
+  fflush(stdout);
+}
+
+const char *path(const char *name) {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "/tmp/macaddress_test_%ld_%s",
+           static_cast<long>(getpid()), name);
+  _paths.push_back(buffer);
+  remove(buffer);
+  return _paths.back().c_str();
+}
+
+Group::Group(const char *name, void (*fn)(void))
+    : name{name}, fn{fn}, next{nullptr} {
+  // keep the registration order of each translation unit
+  Group **tail = &_groups;
+  while (*tail)
+    tail = &(*tail)->next;
+  *tail = this;
+}
+
+} // namespace test
+
+int main(int argc, char *argv[]) {
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+
+  for (test::Group *g = test::_groups; g; g = g->next) {
+    if (filter != nullptr && strstr(g->name, filter) == nullptr)
+      continue;
+    printf("%s\n", g->name);
+    fflush(stdout);
+    g->fn();
+  }
+
+  for (const std::string &p : test::_paths)
+    remove(p.c_str());
+
+  printf("%lu checks, %lu failed\n", test::_checks, test::_failures);
+  return test::_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+#ifndef _test_h_
+#define _test_h_
+
+/*
+ *      @file: test.h
+ *
+ * Tiny test harness for the host build of the MACAddress library.
+ *
+ * Checks are grouped in functions registered through TEST_GROUP(); a failed
+ * CHECK() reports its file, line and expression and makes the program exit
+ * with a non-zero status. Groups can be selected from the command line by a
+ * substring of their name:
+ *
+ *   macaddress_test [filter]
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Arduino.h>
+
+namespace test {
+
+void check(bool ok, const char *expression, const char *file, int line);
+
+// Temporary file path unique to the process (removed at exit)
+const char *path(const char *name);
+
+struct Group {
+  const char *name;
+  void (*fn)(void);
+  Group *next;
+
+  Group(const char *name, void (*fn)(void));
+};
+
+} // namespace test
+
+#define CHECK(expression)                                                      \
+  test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#define TEST_GROUP(name)                                                       \
+  static void test_group_##name(void);                                         \
+  static test::Group test_group_registrar_##name{#name, test_group_##name};    \
+  static void test_group_##name(void)
+
+#endif // _test_h_
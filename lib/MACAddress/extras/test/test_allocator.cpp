@@ -0,0 +1,102 @@
+/*
+ *      @file: test_allocator.cpp
+ *
+ * MACAddressAllocator: exhaustion, oversized claims and uniqueness across
+ * threads.
+ */
+
+#include "test.h"
+
+#include <MACAddressAllocator.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+TEST_GROUP(allocator) {
+  const MAC48 base{0xCA, 0xFE, 0xBA, 0x12, 0x34, 0x56};
+
+  // a range of 10 ids
+  MACAddressAllocator small{base, MA::L, 0xFFFFF6};
+  CHECK(small.remaining() == 10);
+  MAC48 mac, first;
+  CHECK(small.allocate(mac));
+  CHECK(mac == MAC48{0xCAFEBAFFFFF6ull});
+  CHECK(small.allocate(4, first) == 4);
+  CHECK(first == MAC48{0xCAFEBAFFFFF7ull});
+  CHECK(small.allocate(100, first) == 5); // less at the end of the range
+  CHECK(first == MAC48{0xCAFEBAFFFFFBull});
+  CHECK(small.exhausted());
+  CHECK(!small.allocate(mac));
+  CHECK(small.allocate(1, first) == 0);
+  CHECK(small.remaining() == 0);
+
+  // a claim larger than what is left never wraps the counter around
+  MACAddressAllocator block{base, MA::L};
+  for (int i = 0; i != 5; ++i)
+    CHECK(block.allocate(mac));
+  CHECK(block.allocate(~0ull - 2, first) == 0x1000000 - 5);
+  CHECK(first == MAC48{0xCAFEBA000005ull});
+  CHECK(block.remaining() == 0);
+  CHECK(!block.allocate(mac));
+  CHECK(block.allocate(~0ull, first) == 0);
+  CHECK(block.remaining() == 0);
+
+  // leases
+  MACAddressAllocator leased{base, MA::S, 0xFFFFFFFF0ull};
+  MACAddressAllocator::Lease lease;
+  CHECK(leased.reserve(12, lease));
+  CHECK(lease.remaining() == 12);
+  MACAddressAllocator::Lease rest;
+  CHECK(leased.reserve(12, rest));
+  CHECK(rest.remaining() == 4);
+  CHECK(!leased.reserve(1, rest));
+  int handed{0};
+  while (lease.next(mac))
+    ++handed;
+  CHECK(handed == 12);
+  CHECK(mac == MAC48{0xCAFFFFFFFFFBull});
+
+  // from a MACAddress: the rest of its block
+  MACAddress from{"CA:FE:BA:FF:FF:FE"};
+  from.ma = MA::M;
+  MACAddressAllocator tail{from};
+  CHECK(tail.remaining() == 0xFFFFFFF - 0xAFFFFFE + 1);
+}
+
+TEST_GROUP(allocator_threads) {
+  const unsigned threads{4};
+  const uint64_t size{40000};
+  MACAddressAllocator allocator{MAC48{0x02, 0, 0, 0, 0, 0}, MA::S, 0, size};
+
+  std::vector<std::vector<uint64_t>> ids(threads);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t != threads; ++t)
+    workers.emplace_back([&allocator, &ids, t] {
+      MAC48 mac;
+      uint64_t n;
+      for (uint64_t k = 0;; ++k)
+        if (k % 3 == 0) {
+          if (!allocator.allocate(mac))
+            break;
+          ids[t].push_back(mac.getExtensionId36());
+        } else if ((n = allocator.allocate(k % 50, mac)) != 0) {
+          for (uint64_t i = 0; i != n; ++i)
+            ids[t].push_back(mac.getExtensionId36() + i);
+        }
+    });
+  for (auto &w : workers)
+    w.join();
+
+  // every id handed out exactly once
+  std::vector<uint64_t> all;
+  for (auto &v : ids)
+    all.insert(all.end(), v.begin(), v.end());
+  std::sort(all.begin(), all.end());
+  CHECK(all.size() == size);
+  bool consecutive{true};
+  for (uint64_t i = 0; i != all.size(); ++i)
+    consecutive = consecutive && all[i] == i;
+  CHECK(consecutive);
+  CHECK(allocator.remaining() == 0);
+}
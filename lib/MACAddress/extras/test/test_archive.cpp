@@ -0,0 +1,127 @@
+/*
+ *      @file: test_archive.cpp
+ *
+ * MACAddressArchive round trips, chunk lookups and corrupted files.
+ */
+
+#include "test.h"
+
+#include <MACAddressArchive.h>
+#include <MACAddressBatch.h>
+
+#ifdef MACADDRESS_HAS_STDIO
+
+#include <algorithm>
+#include <vector>
+
+// Scattered addresses of a few OUIs, with duplicates
+static std::vector<MAC48> _addresses(size_t count) {
+  std::vector<MAC48> rc(count);
+  uint64_t x{0x9E3779B97F4A7C15ull};
+  for (size_t i = 0; i != count; ++i) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    rc[i] = MAC48{(x >> 16) % 5 << 24 | (x >> 40) % 50000};
+  }
+  return rc;
+}
+
+static bool _write(const char *path, const std::vector<MAC48> &macs,
+                   uint32_t chunk) {
+  MACAddressArchive::Writer writer{chunk};
+  if (!writer.open(path))
+    return false;
+  // a MAC48, a MACAddress, then the rest packed
+  bool ok = writer.add(macs[0]) && writer.add(MACAddress{macs[1]});
+  std::vector<uint8_t> octets(MACAddressBatch::octets_size * macs.size());
+  for (size_t i = 2; i != macs.size(); ++i)
+    macs[i].toOctets(&octets[MACAddressBatch::octets_size * (i - 2)]);
+  ok = ok && writer.add(octets.data(), macs.size() - 2);
+  return writer.size() == macs.size() && writer.close() && ok;
+}
+
+TEST_GROUP(archive) {
+  const char *path = test::path("archive.mpk");
+  const uint32_t chunk{1000};
+  std::vector<MAC48> macs = _addresses(25000);
+  CHECK(_write(path, macs, chunk));
+
+  // every chunk comes back sorted
+  MACAddressArchive::Reader reader;
+  CHECK(reader.open(path));
+  CHECK(reader.size() == macs.size() && reader.chunks() == 25);
+  CHECK(!reader.ordered());
+  std::vector<MAC48> read(macs.size() + 1);
+  CHECK(reader.read(read.data(), 777) == 777);
+  CHECK(reader.read(read.data() + 777, read.size()) == macs.size() - 777);
+  CHECK(!reader.failed());
+  read.pop_back();
+  bool sorted{true};
+  for (size_t i = 0; i != macs.size(); i += chunk) {
+    sorted = sorted &&
+             std::is_sorted(read.begin() + i, read.begin() + i + chunk) &&
+             reader.first(static_cast<uint32_t>(i / chunk)) == read[i];
+    std::sort(macs.begin() + i, macs.begin() + i + chunk);
+  }
+  CHECK(sorted);
+  CHECK(read == macs);
+
+  // a sorted input gives ordered chunks
+  std::sort(macs.begin(), macs.end());
+  CHECK(_write(path, macs, chunk));
+  CHECK(reader.open(path) && reader.ordered());
+  const MAC48 target = macs[12345];
+  const uint32_t i = reader.chunkOf(target);
+  CHECK(i == 12);
+  CHECK(reader.seek(i));
+  std::vector<MAC48> found(chunk);
+  CHECK(reader.read(found.data(), chunk) == chunk);
+  CHECK(std::binary_search(found.begin(), found.end(), target));
+  CHECK(reader.chunkOf(MAC48{0}) == reader.chunks() || macs[0] == MAC48{0});
+
+  uint8_t octets[6 * 3];
+  CHECK(reader.seek(0) && reader.read(octets, 3) == 3);
+  CHECK(MAC48::fromOctets(octets + 6) == macs[1]);
+  MACAddress mac;
+  CHECK(reader.read(mac) && mac.toMAC48() == macs[3]);
+  reader.close();
+
+  // an empty archive
+  MACAddressArchive::Writer empty;
+  CHECK(empty.open(path) && empty.close());
+  CHECK(reader.open(path) && reader.size() == 0 && reader.chunks() == 0);
+  CHECK(reader.read(found.data(), chunk) == 0 && !reader.failed());
+}
+
+TEST_GROUP(archive_corrupted) {
+  const char *path = test::path("corrupted.mpk");
+  const std::vector<MAC48> macs = _addresses(5000);
+  CHECK(_write(path, macs, 1000));
+
+  FILE *file = fopen(path, "rb");
+  std::vector<char> bytes;
+  for (int c; (c = fgetc(file)) != EOF;)
+    bytes.push_back(static_cast<char>(c));
+  fclose(file);
+
+  MACAddressArchive::Reader reader;
+  // truncated
+  file = fopen(path, "wb");
+  fwrite(bytes.data(), 1, bytes.size() - 1, file);
+  fclose(file);
+  CHECK(!reader.open(path) && !reader.isOpen());
+
+  // varints too long at the start of the first chunk (after the 16 bytes
+  // header and the 8 bytes chunk header): the chunk fails to decode
+  std::vector<char> damaged = bytes;
+  std::fill(damaged.begin() + 16 + 8, damaged.begin() + 16 + 8 + 12, '\xFF');
+  file = fopen(path, "wb");
+  fwrite(damaged.data(), 1, damaged.size(), file);
+  fclose(file);
+  std::vector<MAC48> read(macs.size());
+  CHECK(reader.open(path));
+  CHECK(reader.read(read.data(), read.size()) == 0 && reader.failed());
+  CHECK(reader.seek(1) && !reader.failed());
+  CHECK(reader.read(read.data(), read.size()) == 4000);
+}
+
+#endif // MACADDRESS_HAS_STDIO
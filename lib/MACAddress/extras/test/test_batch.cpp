@@ -0,0 +1,114 @@
+/*
+ *      @file: test_batch.cpp
+ *
+ * MACAddressBatch: the bulk parser and formatter give the same results as
+ * the scalar ones, whichever path (SIMD or not) handles an entry.
+ */
+
+#include "test.h"
+
+#include <MACAddressBatch.h>
+
+#include <string>
+#include <vector>
+
+// Entries of every kind: canonical (SIMD path), compact, invalid
+static std::string _entry(uint32_t i) {
+  char entry[32];
+  const unsigned a = (i * 2654435761u) >> 8;
+  switch (i % 6) {
+  case 0:
+  case 1:
+    snprintf(entry, sizeof(entry), "%02X:%02x:%02X:%02x:%02X:%02x", a & 0xFF,
+             a >> 8 & 0xFF, a >> 16 & 0xFF, i & 0xFF, i >> 8 & 0xFF, i % 7);
+    break;
+  case 2:
+    snprintf(entry, sizeof(entry), "%02X-%02X-%02X-%02X-%02X-%02X", i & 0xFF,
+             a & 0xFF, a >> 8 & 0xFF, a >> 16 & 0xFF, 0, i % 5);
+    break;
+  case 3:
+    snprintf(entry, sizeof(entry), "%x::%x:%x::%x", a & 0xF, a >> 4 & 0xFF,
+             i & 0xFF, a >> 12 & 0xF);
+    break;
+  case 4: // one bad character
+    snprintf(entry, sizeof(entry), "%02X:%02X:%02X:%02X:%02X:%02X", a & 0xFF,
+             a >> 8 & 0xFF, i & 0xFF, 1, 2, 3);
+    entry[(i / 6) % 17] = "gG :-.x"[i % 7];
+    break;
+  default: // too short or too long
+    snprintf(entry, sizeof(entry), i & 1 ? "%02X:%02X:%02X:%02X:%02X"
+                                         : "%02X:%02X:%02X:%02X:%02X:%02X:1",
+             a & 0xFF, i & 0xFF, 1, 2, 3, 4);
+  }
+  return entry;
+}
+
+TEST_GROUP(batch_parse) {
+  const size_t count{4096};
+  std::string text;
+  for (uint32_t i = 0; i != count; ++i)
+    text += _entry(i) + (i % 3 == 0 ? "\r\n" : i % 3 == 1 ? "\n" : ",");
+
+  std::vector<uint8_t> octets(count * MACAddressBatch::octets_size);
+  std::vector<uint8_t> valid((count + 7) / 8);
+  size_t consumed{0};
+  CHECK(MACAddressBatch::parse(text.data(), text.size(), octets.data(),
+                               valid.data(), count, &consumed) == count);
+  CHECK(consumed == text.size());
+
+  for (uint32_t i = 0; i != count; ++i) {
+    uint8_t expected[6];
+    const bool ok = MACAddressParser::parse(_entry(i).c_str(), expected) ==
+                    MACAddressParser::Status::OK;
+    if (!ok)
+      memset(expected, 0xFF, sizeof(expected));
+    CHECK(MACAddressBatch::isValid(valid.data(), i) == ok);
+    CHECK(memcmp(&octets[i * MACAddressBatch::octets_size], expected,
+                 sizeof(expected)) == 0);
+  }
+
+  // in chunks of complete entries: the same result
+  std::vector<uint8_t> chunked(octets.size());
+  std::vector<uint8_t> chunk_valid(1);
+  size_t offset{0};
+  for (uint32_t i = 0; i != count; ++i) {
+    size_t used{0};
+    CHECK(MACAddressBatch::parse(text.data() + offset, text.size() - offset,
+                                 &chunked[i * MACAddressBatch::octets_size],
+                                 chunk_valid.data(), 1, &used) == 1);
+    CHECK(MACAddressBatch::isValid(chunk_valid.data(), 0) ==
+          MACAddressBatch::isValid(valid.data(), i));
+    offset += used;
+  }
+  CHECK(offset == text.size());
+  CHECK(chunked == octets);
+}
+
+TEST_GROUP(batch_format) {
+  const size_t count{1027}; // not a multiple of the SIMD steps
+  std::vector<uint8_t> octets(count * MACAddressBatch::octets_size);
+  uint32_t x{12345};
+  for (size_t i = 0; i != octets.size(); ++i) {
+    x = x * 1103515245u + 12345u;
+    // plenty of zeroed and single digit octets for the compact form
+    octets[i] = static_cast<uint8_t>((x >> 16) % 3 ? x >> 24 : x >> 28);
+  }
+
+  const Representation representations[]{Representation::COMMON_FULL,
+                                         Representation::EUI48,
+                                         Representation::COMMON_COMPACT};
+  for (uint8_t r = 0; r != 3; ++r) {
+    std::vector<char> text(MACAddressBatch::formatSize(count));
+    const size_t length = MACAddressBatch::format(
+        octets.data(), count, representations[r], text.data(), ',');
+
+    std::string expected;
+    for (size_t i = 0; i != count; ++i) {
+      char entry[MACAddressFormat::size];
+      expected.append(entry, MACAddressFormat::write(
+                                 entry, &octets[i * 6], representations[r]));
+      expected += ',';
+    }
+    CHECK(std::string(text.data(), length) == expected);
+  }
+}
@@ -0,0 +1,154 @@
+/*
+ *      @file: test_capture.cpp
+ *
+ * MACAddressCapture: pcap and pcapng files analyzed by one or many threads
+ * give the traffic counted while writing them.
+ */
+
+#include "test.h"
+
+#include <MACAddressCapture.h>
+
+#if defined(MACADDRESS_HAS_MMAP) && defined(MACADDRESS_HAS_THREAD)
+
+#include <map>
+#include <vector>
+
+struct CaptureExpected {
+  std::map<uint64_t, MACAddressTraffic> addresses;
+  uint64_t frames{0};
+  uint64_t bytes{0};
+};
+
+static uint64_t _random(uint64_t &seed) {
+  seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+  return seed >> 16;
+}
+
+// Random frame between two of 500 addresses, counted into expected
+static std::vector<uint8_t> _frame(uint64_t &seed, CaptureExpected &expected) {
+  std::vector<uint8_t> frame(14 + _random(seed) % 1500);
+  for (size_t i = 12; i != frame.size(); ++i)
+    frame[i] = static_cast<uint8_t>(_random(seed));
+  const MAC48 destination{0x0008AB000000ull + _random(seed) % 500};
+  const MAC48 source{0x0208AB000000ull + _random(seed) % 500};
+  destination.toOctets(&frame[0]);
+  source.toOctets(&frame[6]);
+
+  ++expected.frames;
+  expected.bytes += frame.size();
+  expected.addresses[destination.value()].rx_frames++;
+  expected.addresses[destination.value()].rx_bytes += frame.size();
+  expected.addresses[source.value()].tx_frames++;
+  expected.addresses[source.value()].tx_bytes += frame.size();
+  return frame;
+}
+
+static void _put32(std::vector<uint8_t> &out, uint32_t n) {
+  out.insert(out.end(), reinterpret_cast<uint8_t *>(&n),
+             reinterpret_cast<uint8_t *>(&n) + 4);
+}
+
+static bool _save(const char *path, const std::vector<uint8_t> &data) {
+  FILE *file = fopen(path, "wb");
+  if (file == nullptr)
+    return false;
+  const bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+  return fclose(file) == 0 && ok;
+}
+
+static bool _same(const MACAddressCapture &capture,
+                  const CaptureExpected &expected) {
+  bool same = capture.frames() == expected.frames &&
+              capture.bytes() == expected.bytes &&
+              capture.addresses().size() == expected.addresses.size();
+  for (const auto &entry : expected.addresses) {
+    const MACAddressTraffic *t = capture.addresses().find(MAC48{entry.first});
+    same = same && t != nullptr && t->tx_frames == entry.second.tx_frames &&
+           t->tx_bytes == entry.second.tx_bytes &&
+           t->rx_frames == entry.second.rx_frames &&
+           t->rx_bytes == entry.second.rx_bytes;
+  }
+  return same;
+}
+
+TEST_GROUP(capture_pcap) {
+  // a few MB: several ranges of at least 1 MB
+  CaptureExpected expected;
+  std::vector<uint8_t> data;
+  const uint32_t header[6]{0xA1B2C3D4, 0x00040002, 0, 0, 65535, 1};
+  for (uint32_t h : header)
+    _put32(data, h);
+  uint64_t seed{7};
+  while (data.size() < (5 << 20)) {
+    const std::vector<uint8_t> frame = _frame(seed, expected);
+    const uint32_t record[4]{1, 2, static_cast<uint32_t>(frame.size()),
+                             static_cast<uint32_t>(frame.size())};
+    for (uint32_t r : record)
+      _put32(data, r);
+    data.insert(data.end(), frame.begin(), frame.end());
+  }
+  const char *path = test::path("trace.pcap");
+  CHECK(_save(path, data));
+
+  MACAddressCapture capture;
+  CHECK(capture.open(path));
+  CHECK(capture.format() == MACAddressCapture::Format::PCAP);
+  CHECK(capture.analyze(1) == expected.frames);
+  CHECK(_same(capture, expected));
+  CHECK(capture.analyze(4) == expected.frames);
+  CHECK(_same(capture, expected));
+
+  // OUIs: the two vendors
+  CHECK(capture.ouis().size() == 2);
+  const MACAddressTraffic *oui = capture.ouis().find(MAC48{0x0008AB000000ull});
+  CHECK(oui != nullptr && oui->rx_frames == expected.frames &&
+        oui->tx_frames == 0);
+
+  // truncated in the middle of a record: analyzed up to the last one
+  data.resize(data.size() - 20);
+  CHECK(_save(path, data));
+  CHECK(capture.open(path));
+  CHECK(capture.analyze(4) == expected.frames - 1);
+
+  CHECK(_save(path, std::vector<uint8_t>(64, 0x55)));
+  CHECK(!capture.open(path));
+}
+
+TEST_GROUP(capture_pcapng) {
+  CaptureExpected expected;
+  std::vector<uint8_t> data;
+  // section header block and interface description block (Ethernet)
+  const uint32_t shb[7]{0x0A0D0D0A, 28, 0x1A2B3C4D, 0x00000001,
+                        0xFFFFFFFF, 0xFFFFFFFF, 28};
+  const uint32_t idb[5]{1, 20, 1, 65535, 20};
+  for (uint32_t n : shb)
+    _put32(data, n);
+  for (uint32_t n : idb)
+    _put32(data, n);
+
+  uint64_t seed{11};
+  while (data.size() < (3 << 20)) {
+    std::vector<uint8_t> frame = _frame(seed, expected);
+    const uint32_t length = static_cast<uint32_t>(frame.size());
+    frame.resize((frame.size() + 3) & ~static_cast<size_t>(3));
+    const uint32_t total = 32 + static_cast<uint32_t>(frame.size());
+    const uint32_t epb[7]{6, total, 0, 0, 0, length, length};
+    for (uint32_t n : epb)
+      _put32(data, n);
+    data.insert(data.end(), frame.begin(), frame.end());
+    _put32(data, total);
+  }
+  const char *path = test::path("trace.pcapng");
+  CHECK(_save(path, data));
+
+  MACAddressCapture capture;
+  CHECK(capture.open(path));
+  CHECK(capture.format() == MACAddressCapture::Format::PCAPNG);
+  CHECK(capture.analyze(1) == expected.frames);
+  CHECK(_same(capture, expected));
+  CHECK(capture.analyze(3) == expected.frames);
+  CHECK(_same(capture, expected));
+}
+
+#endif // MACADDRESS_HAS_MMAP && MACADDRESS_HAS_THREAD
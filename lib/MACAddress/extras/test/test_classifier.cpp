@@ -0,0 +1,108 @@
+/*
+ *      @file: test_classifier.cpp
+ *
+ * MACAddressPrefix parsing and matching, and MACAddressClassifier against a
+ * linear scan of its rules.
+ */
+
+#include "test.h"
+
+#include <MACAddressBatch.h>
+#include <MACAddressClassifier.h>
+
+#include <algorithm>
+#include <vector>
+
+static_assert(MAC48{MAC48::mask48}.isBroadcast(), "");
+static_assert(MAC48{MAC48::ig_bit}.isMulticast(), "");
+static_assert(MAC48{MAC48::ul_bit}.isLocal(), "");
+static_assert(MACAddressPrefix::local().mask().value() == MAC48::ul_bit, "");
+
+TEST_GROUP(prefix) {
+  MACAddressPrefix prefix;
+  CHECK(MACAddressPrefix::parse("AB:CD:E", prefix));
+  CHECK(prefix == MACAddressPrefix("AB:CD:E0:00:00:00"_mac, 20));
+  CHECK(MACAddressPrefix::parse("AB-CD-EF/28", prefix));
+  CHECK(prefix == MACAddressPrefix("AB:CD:EF:00:00:00"_mac, 28));
+  CHECK(MACAddressPrefix::parse("abcdef12", prefix));
+  CHECK(prefix.mask() == "FF:FF:FF:FF:00:00"_mac);
+  CHECK(MACAddressPrefix::parse("02/02:00:00:00:00:00", prefix));
+  CHECK(prefix == MACAddressPrefix::local());
+  const MACAddressPrefix untouched = prefix;
+  CHECK(!MACAddressPrefix::parse("AB:CD:EF/49", prefix));
+  CHECK(!MACAddressPrefix::parse("AB:CG", prefix));
+  CHECK(!MACAddressPrefix::parse("AB:CD/FF:FF:FF", prefix));
+  CHECK(prefix == untouched);
+
+  // the bits outside of the mask are cleared
+  CHECK(MACAddressPrefix("AB:CD:EF:01:23:45"_mac, 24).value() ==
+        "AB:CD:EF:00:00:00"_mac);
+  CHECK(MACAddressPrefix("AB:CD:EF:01:23:45"_mac, 0)
+            .matches("1:2:3:4:5:6"_mac));
+  const MACAddressPrefix block =
+      MACAddressPrefix::block("AB:CD:EF:12:34:56"_mac, MA::M);
+  CHECK(block.matches("AB:CD:EF:FF:FF:FF"_mac));
+  CHECK(block.matches("AB:CD:E0:00:00:00"_mac));
+  CHECK(!block.matches("AB:CD:D0:FF:FF:FF"_mac));
+  // bound to references (ODR-used): defined once in the library
+  const uint64_t all = ~0ull;
+  CHECK(std::min(MAC48::mask48, all) == 0xFFFFFFFFFFFFull);
+  CHECK(std::max(MAC48::ig_bit, MAC48::ul_bit) == 0x020000000000ull);
+  CHECK(MACAddressPrefix::multicast().matches("01:00:5E:00:00:01"_mac));
+  CHECK(!MACAddressPrefix::multicast().matches("02:00:5E:00:00:01"_mac));
+}
+
+TEST_GROUP(classifier) {
+  std::vector<MACAddressPrefix> prefixes;
+  MACAddressClassifier classifier;
+  uint32_t x{0xC0FFEE};
+  for (uint32_t i = 0; i != 2000; ++i) {
+    x = x * 1664525u + 1013904223u;
+    const uint8_t lengths[]{24, 28, 36, 20, 48};
+    const MAC48 value{static_cast<uint64_t>(x % 64) << 24 |
+                      static_cast<uint64_t>(x >> 8) << 8};
+    prefixes.push_back(MACAddressPrefix(value, lengths[x % 5]));
+    CHECK(classifier.add(prefixes.back()) == i);
+  }
+  prefixes.push_back(MACAddressPrefix::local());
+  CHECK(classifier.add(prefixes.back()) == 2000);
+  CHECK(classifier.size() == 2001 && classifier.masks() == 6);
+
+  const size_t count{5000};
+  std::vector<MAC48> macs(count);
+  std::vector<uint8_t> octets(count * MACAddressBatch::octets_size);
+  for (size_t i = 0; i != count; ++i) {
+    x = x * 1664525u + 1013904223u;
+    // half of them derived from a rule, so that most match one
+    macs[i] = i & 1 ? MAC48{prefixes[x % 2000].value().value() | (x & 0xFFF)}
+                    : MAC48{static_cast<uint64_t>(x) << 16 | (x >> 16)};
+    macs[i].toOctets(&octets[i * MACAddressBatch::octets_size]);
+  }
+
+  std::vector<uint32_t> rules(count), packed(count);
+  classifier.classify(macs.data(), count, rules.data());
+  classifier.classify(octets.data(), count, packed.data());
+  bool same{true};
+  size_t matched{0};
+  for (size_t i = 0; i != count; ++i) {
+    uint32_t expected = MACAddressClassifier::none;
+    for (uint32_t r = 0; r != prefixes.size(); ++r)
+      if (prefixes[r].matches(macs[i])) {
+        expected = r;
+        break;
+      }
+    matched += expected != MACAddressClassifier::none;
+    same = same && classifier.classify(macs[i]) == expected &&
+           rules[i] == expected && packed[i] == expected;
+  }
+  CHECK(same);
+  CHECK(matched > count / 2);
+
+  // a mask more than the classifier holds
+  MACAddressClassifier few;
+  for (uint8_t length = 1; length <= MACAddressClassifier::max_masks;
+       ++length)
+    CHECK(few.add(MACAddressPrefix(MAC48{}, length)) !=
+          MACAddressClassifier::none);
+  CHECK(few.add(MACAddressPrefix(MAC48{}, 47)) == MACAddressClassifier::none);
+}
@@ -0,0 +1,81 @@
+/*
+ *      @file: test_derivation.cpp
+ *
+ * MACAddressDerivation: ranges, both rules and the packed arrays.
+ */
+
+#include "test.h"
+
+#include <MACAddressBatch.h>
+#include <MACAddressDerivation.h>
+
+#include <vector>
+
+typedef MACAddressDerivation::Rule Rule;
+
+TEST_GROUP(derivation) {
+  uint32_t first;
+  uint64_t count;
+  CHECK(MACAddressDerivation::parseRange("10.1.2.3/16", first, count));
+  CHECK(first == MACAddressDerivation::ipv4(10, 1, 0, 0) && count == 65536);
+  CHECK(MACAddressDerivation::parseRange("0.0.0.0/0", first, count));
+  CHECK(first == 0 && count == 0x100000000ull);
+  CHECK(MACAddressDerivation::parseRange("10.0.0.10-10.0.0.99", first, count));
+  CHECK(first == MACAddressDerivation::ipv4(10, 0, 0, 10) && count == 90);
+  CHECK(MACAddressDerivation::parseRange("192.168.1.234", first, count));
+  CHECK(count == 1);
+  CHECK(!MACAddressDerivation::parseRange("10.0.0.99-10.0.0.10", first, count));
+  CHECK(!MACAddressDerivation::parseRange("10.0.0.256", first, count));
+  CHECK(!MACAddressDerivation::parseRange("10.0.0/8", first, count));
+  CHECK(!MACAddressDerivation::parseRange("10.0.0.0/33", first, count));
+
+  const MAC48 base{0x00, 0x08, 0xAB, 0xFF, 0xFF, 0x00};
+  CHECK(MACAddressDerivation::derive(base, Rule::EMBED, 0,
+                                     MACAddressDerivation::ipv4(
+                                         192, 168, 1, 234)) ==
+        MAC48{0x0008C0A801EAull});
+
+  // OFFSET must fit the MA block of base
+  CHECK(MACAddressDerivation::fits(base, MA::L, Rule::OFFSET, 0, 256));
+  CHECK(!MACAddressDerivation::fits(base, MA::L, Rule::OFFSET, 0, 257));
+  CHECK(MACAddressDerivation::fits(base, MA::M, Rule::OFFSET, 0, 257));
+  CHECK(!MACAddressDerivation::fits(base, MA::L, Rule::EMBED, 0xFFFFFFFF, 2));
+
+  // the packed array holds the addresses of forEach(), whatever the count
+  const size_t counts[]{1, 2, 3, 1000};
+  const Rule rules[]{Rule::EMBED, Rule::OFFSET};
+  for (Rule rule : rules)
+    for (size_t n : counts) {
+      std::vector<uint8_t> octets(n * MACAddressBatch::octets_size + 2, 0xEE);
+      CHECK(MACAddressDerivation::derive(base, MA::M, rule, 0x0A000001, n,
+                                         octets.data()) == n);
+      CHECK(octets[n * 6] == 0xEE && octets[n * 6 + 1] == 0xEE);
+      bool same{true};
+      CHECK(MACAddressDerivation::forEach(
+                base, MA::M, rule, 0x0A000001, n,
+                [&](uint32_t ip, MAC48 mac) {
+                  same = same &&
+                         MAC48::fromOctets(&octets[(ip - 0x0A000001) * 6]) ==
+                             mac;
+                  return true;
+                }) == n);
+      CHECK(same);
+    }
+
+  std::vector<uint8_t> octets(6 * 300, 0xEE);
+  CHECK(MACAddressDerivation::derive(base, MA::L, Rule::OFFSET, 0, 300,
+                                     octets.data()) == 0);
+  CHECK(octets[0] == 0xEE);
+
+  // collisions with the addresses already in use
+  MACAddressSet existing;
+  existing.insert(MAC48{0x0008ABFFFF00ull});
+  existing.insert(MAC48{0x0008ABFFFF09ull});
+  existing.insert(MAC48{0x0008ABFFFFFFull});
+  CHECK(MACAddressDerivation::derive(base, MA::L, Rule::OFFSET, 0, 10,
+                                     octets.data()) == 10);
+  uint8_t found[2];
+  CHECK(MACAddressDerivation::collisions(octets.data(), 10, existing, found) ==
+        2);
+  CHECK(found[0] == 0x01 && found[1] == 0x02);
+}
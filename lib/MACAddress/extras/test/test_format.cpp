@@ -0,0 +1,103 @@
+/*
+ *      @file: test_format.cpp
+ *
+ * Formatting into caller supplied buffers: toChars, hexToChars and their
+ * use from concurrent threads.
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string _chars(const MACAddress &mac,
+                          Representation representation) {
+  char text[MACAddressFormat::size];
+  char *end = mac.toChars(text, text + sizeof(text), representation);
+  return end ? std::string(text, end) : std::string("(nullptr)");
+}
+
+static std::string _hex(uint64_t n, size_t size = 16) {
+  char text[16];
+  char *end = MACAddressFormat::hexToChars(text, text + size, n);
+  return end ? std::string(text, end) : std::string("(nullptr)");
+}
+
+TEST_GROUP(format) {
+  const MACAddress mac{0x0A, 0x1B, 0x00, 0x01, 0xF0, 0x0C};
+  CHECK(_chars(mac, Representation::COMMON_FULL) == "0A:1B:00:01:F0:0C");
+  CHECK(_chars(mac, Representation::EUI48) == "0A-1B-00-01-F0-0C");
+  CHECK(_chars(mac, Representation::COMMON_COMPACT) == "A:1B::1:F0:C");
+
+  // a buffer too small is left untouched
+  char text[MACAddressFormat::size];
+  memset(text, '#', sizeof(text));
+  CHECK(mac.toChars(text, text + MACAddressFormat::size - 1) == nullptr);
+  CHECK(text[0] == '#');
+  CHECK(mac.toChars(text, text) == nullptr);
+
+  CHECK(_hex(0) == "0");
+  CHECK(_hex(0xABC) == "ABC");
+  CHECK(_hex(0x8AB123456ull) == "8AB123456");
+  CHECK(_hex(~0ull) == "FFFFFFFFFFFFFFFF");
+  CHECK(_hex(0x10000, 4) == "(nullptr)");
+  CHECK(_hex(0xFFFF, 4) == "FFFF");
+  CHECK(_hex(0, 0) == "(nullptr)");
+
+  MACAddress shared;
+  CHECK(strcmp(shared.uint64ToHex(0x123), "123") == 0);
+  CHECK(strcmp(shared.uint64ToHex(0), "0") == 0);
+}
+
+// Each thread formats its own addresses, comparing them with the text they
+// were made of: the outputs of concurrent calls never mix
+TEST_GROUP(format_threads) {
+  const unsigned threads{4};
+  std::vector<unsigned> failures(threads);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t != threads; ++t)
+    workers.emplace_back([t, &failures] {
+      const MACAddress mac{MAC48{0x1122334455ull | uint64_t{0x10 * t} << 40}};
+      char expected[MAC48::str_size];
+      snprintf(expected, sizeof(expected), "%02X:11:22:33:44:55", 0x10 * t);
+      char hex[2];
+      for (unsigned i = 0; i != 20000; ++i) {
+        char *end = MACAddressFormat::hexToChars(hex, hex + sizeof(hex), t);
+        failures[t] += _chars(mac, Representation::COMMON_FULL) != expected ||
+                       end != hex + 1 || hex[0] != static_cast<char>('0' + t);
+      }
+    });
+  for (std::thread &worker : workers)
+    worker.join();
+  for (unsigned t = 0; t != threads; ++t)
+    CHECK(failures[t] == 0);
+}
+
+// Every mix of zeroed, single digit and two digits octets, against the
+// compact text built digit by digit; nothing is written past size characters
+TEST_GROUP(format_compact) {
+  const uint8_t values[]{0x00, 0x0A, 0xB7};
+  size_t mismatches{0}, overruns{0};
+  for (unsigned mix = 0; mix != 729; ++mix) {
+    uint8_t octets[6];
+    std::string expected;
+    for (unsigned i = 0, m = mix; i != 6; ++i, m /= 3) {
+      octets[i] = values[m % 3];
+      char digits[3];
+      snprintf(digits, sizeof(digits), "%X", octets[i]);
+      expected += (i ? ":" : "") + std::string(octets[i] ? digits : "");
+    }
+
+    char text[MACAddressFormat::size + 1];
+    memset(text, '#', sizeof(text));
+    char *end = MACAddressFormat::write(text, octets,
+                                        Representation::COMMON_COMPACT);
+    mismatches += std::string(text, end) != expected;
+    overruns += text[MACAddressFormat::size] != '#';
+  }
+  CHECK(mismatches == 0);
+  CHECK(overruns == 0);
+}
@@ -0,0 +1,131 @@
+/*
+ *      @file: test_generator.cpp
+ *
+ * MACAddressGenerator over a MACAddressFileStorage: reboots, ring
+ * wrap-around and writes torn by a reset.
+ */
+
+#include "test.h"
+
+#include <MACAddressGenerator.h>
+
+#include <set>
+
+static const MAC48 _base{"00:08:AB:00:10:00"_mac};
+
+// A storage whose write number tear (from 1) only writes its first half and
+// fails, as a reset in the middle of it would
+class TornStorage : public MACAddressStorage {
+public:
+  TornStorage(MACAddressStorage &storage, unsigned long tear)
+      : _storage(storage), _tear{tear} {}
+
+  virtual size_t size(void) const { return _storage.size(); }
+  virtual bool read(size_t offset, uint8_t data[], size_t length) {
+    return _storage.read(offset, data, length);
+  }
+  virtual bool write(size_t offset, const uint8_t data[], size_t length) {
+    if (++_writes != _tear)
+      return _storage.write(offset, data, length);
+    _storage.write(offset, data, length / 2);
+    return false;
+  }
+
+private:
+  MACAddressStorage &_storage;
+  const unsigned long _tear;
+  unsigned long _writes{0};
+};
+
+// Hands out count addresses, false if any of them was issued before
+static bool _issue(MACAddressGenerator &generator, size_t count,
+                   std::set<uint64_t> &issued) {
+  bool unique{true};
+  for (size_t i = 0; i != count; ++i) {
+    MAC48 mac;
+    if (!generator.next(mac))
+      return false;
+    unique = unique && issued.insert(mac.value()).second;
+  }
+  return unique;
+}
+
+TEST_GROUP(generator) {
+  const char *path = test::path("generator.eeprom");
+  MACAddressFileStorage storage;
+
+  // built before the storage is opened: nothing until begin()
+  MACAddressGenerator generator{storage, _base, MA::L, 4};
+  MAC48 mac;
+  CHECK(!generator.next(mac));
+  CHECK(!generator.begin() && generator.slots() == 0);
+  CHECK(storage.open(path, 5 * MACAddressGenerator::slot_size + 3));
+  CHECK(generator.begin() && generator.slots() == 5);
+  CHECK(generator.position() == _base.getExtensionId24());
+  CHECK(generator.next(mac) && mac == _base);
+
+  // 8 commits of 4 addresses wrap around the ring of 5 slots
+  std::set<uint64_t> issued{mac.value()};
+  CHECK(_issue(generator, 29, issued));
+  CHECK(generator.commits() == 8 && generator.committed() == 0x1020);
+
+  // each reboot resumes from the highest sequence, wherever the ring is
+  uint64_t committed = generator.committed();
+  for (unsigned reboot = 0; reboot != 7; ++reboot) {
+    MACAddressGenerator rebooted{storage, _base, MA::L, 4};
+    CHECK(rebooted.begin() && rebooted.position() == committed);
+    CHECK(_issue(rebooted, 3 + reboot, issued));
+    CHECK(MAC48{*issued.rbegin()} ==
+          _base.withExtensionId24(rebooted.position() - 1));
+    committed = rebooted.committed();
+  }
+  CHECK(issued.size() == 30 + 3 + 4 + 5 + 6 + 7 + 8 + 9);
+
+  // slots of another block are ignored
+  MACAddressGenerator other{storage, "00:08:AC:00:00:00"_mac, MA::L, 4};
+  CHECK(other.begin() && other.position() == 0 && other.committed() == 0);
+
+  // a storage smaller than a slot
+  MACAddressFileStorage small;
+  CHECK(small.open(test::path("small.eeprom"),
+                   MACAddressGenerator::slot_size - 1));
+  MACAddressGenerator none{small, _base, MA::L};
+  CHECK(!none.begin() && !none.next(mac));
+}
+
+TEST_GROUP(generator_torn) {
+  const char *path = test::path("torn.eeprom");
+  for (unsigned long tear = 1; tear != 12; ++tear) {
+    MACAddressFileStorage file;
+    remove(path);
+    CHECK(file.open(path, 5 * MACAddressGenerator::slot_size));
+
+    // addresses until the reset tears a commit
+    TornStorage torn{file, tear};
+    MACAddressGenerator generator{torn, _base, MA::L, 3};
+    CHECK(generator.begin());
+    std::set<uint64_t> issued;
+    MAC48 mac;
+    while (generator.next(mac))
+      issued.insert(mac.value());
+    CHECK(issued.size() == 3 * (tear - 1));
+
+    // the previous slot is recovered, no address is issued twice
+    MACAddressGenerator rebooted{file, _base, MA::L, 3};
+    CHECK(rebooted.begin());
+    CHECK(rebooted.position() == _base.getExtensionId24() + 3 * (tear - 1));
+    CHECK(_issue(rebooted, 10, issued));
+  }
+
+  // the last end committed stands even when at the end of the block
+  MACAddressFileStorage file;
+  remove(path);
+  CHECK(file.open(path, 2 * MACAddressGenerator::slot_size));
+  const MAC48 last = _base.withExtensionId24(0xFFFFFE);
+  MACAddressGenerator generator{file, last, MA::L, 16};
+  MAC48 mac;
+  CHECK(generator.begin() && generator.next(mac) && generator.next(mac));
+  CHECK(mac == _base.withExtensionId24(0xFFFFFF) && !generator.next(mac));
+  MACAddressGenerator rebooted{file, last, MA::L, 16};
+  CHECK(rebooted.begin() && !rebooted.next(mac));
+}
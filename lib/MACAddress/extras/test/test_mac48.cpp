@@ -0,0 +1,126 @@
+/*
+ *      @file: test_mac48.cpp
+ *
+ * MAC48: layout, conversions to and from MACAddress, and the MA setting kept
+ * by the MACAddress copies and arithmetic.
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+
+#include <type_traits>
+
+static_assert(sizeof(MAC48) == 8, "MAC48 is a single 64 bits integer");
+static_assert(std::is_trivially_copyable<MAC48>::value,
+              "MAC48 is trivially copyable");
+
+TEST_GROUP(mac48) {
+  const MAC48 mac{0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+  CHECK(mac.value() == 0xABCDEF012345ull);
+  CHECK(mac[0] == 0xAB && mac[5] == 0x45);
+  CHECK(MAC48{0xFFFFABCDEF012345ull} == mac); // 48 bits only
+
+  uint8_t octets[6];
+  mac.toOctets(octets);
+  CHECK(MAC48::fromOctets(octets) == mac);
+
+  char text[MAC48::str_size];
+  CHECK(strcmp(mac.toString(text), "AB:CD:EF:01:23:45") == 0);
+  CHECK(strcmp(mac.toString(text, Representation::EUI48),
+               "AB-CD-EF-01-23-45") == 0);
+  CHECK(mac.toChars(text, text + 16) == nullptr);
+
+  const MACAddress converted{mac};
+  CHECK(converted == "AB:CD:EF:01:23:45");
+  CHECK(converted.toMAC48() == mac);
+
+  CHECK(MAC48{1} < MAC48{2} && MAC48{0x010000000000ull} > MAC48{0xFF});
+}
+
+TEST_GROUP(mac48_ma) {
+  MACAddress m{"AB:CD:EF:FF:FF:FF"};
+  m.ma = MA::M;
+  const MACAddress copy{m};
+  CHECK(copy.ma == MA::M);
+  MACAddress assigned;
+  assigned = m;
+  CHECK(assigned.ma == MA::M);
+
+  // the result of + and - keeps the MA setting: MA-M wraps 28 bits
+  const MACAddress next = m + 1;
+  CHECK(next.ma == MA::M);
+  CHECK(next == "AB:CD:E0:00:00:00");
+  const MACAddress previous = next - 1;
+  CHECK(previous.ma == MA::M);
+  CHECK(previous == m);
+  CHECK((m + 0x1000000) == "AB:CD:E0:FF:FF:FF");
+
+  MACAddress s{"AB:C0:00:00:00:00"};
+  s.ma = MA::S;
+  CHECK((s - 1).ma == MA::S);
+  CHECK((s - 1) == "AB:CF:FF:FF:FF:FF");
+  CHECK((s + -1) == "AB:CF:FF:FF:FF:FF");
+}
+
+TEST_GROUP(mac48_accessors) {
+  // the packed accessors agree with the octets of the address
+  uint32_t x{0x2545F491u};
+  for (int i = 0; i != 1000; ++i) {
+    uint8_t o[6];
+    for (uint8_t k = 0; k != 6; ++k) {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      o[k] = static_cast<uint8_t>(x);
+    }
+    MACAddress mac{o};
+    CHECK(mac.getOUI24() == (uint32_t{o[0]} << 16 | o[1] << 8 | o[2]));
+    CHECK(mac.getExtensionId24() ==
+          (uint32_t{o[3]} << 16 | o[4] << 8 | o[5]));
+    CHECK(mac.getOUI20() == mac.getOUI24() >> 4);
+    CHECK(mac.getExtensionId28() ==
+          ((mac.getOUI24() & 0xF) << 24 | mac.getExtensionId24()));
+    CHECK(mac.getOUI12() == mac.getOUI24() >> 12);
+    CHECK(mac.getExtensionId36() == (mac.toMAC48().value() & 0xFFFFFFFFFull));
+
+    MACAddress changed{mac};
+    changed.setExtensionId28(0x1234567);
+    CHECK(changed.getOUI20() == mac.getOUI20());
+    CHECK(changed.getExtensionId28() == 0x1234567);
+    changed.setExtensionId36(0xFEDCBA987ull);
+    CHECK(changed.getOUI12() == mac.getOUI12());
+    CHECK(changed.getExtensionId36() == 0xFEDCBA987ull);
+    changed.setExtensionId24(o[3]);
+    CHECK(changed.getExtensionId24() == o[3]);
+  }
+}
+
+// Literals are parsed at compile time
+static_assert("AB:CD:EF:01:23:45"_mac.value() == 0xABCDEF012345ull, "");
+static_assert("8::12:34:56:78"_mac.value() == 0x080012345678ull, "");
+static_assert("ab-cd-ef-1-2-3"_mac.getOUI24() == 0xABCDEF, "");
+static_assert(!MAC48::isValid("AB:CD:EF:01:23", 14), "");
+static_assert(!MAC48::isValid("AB:CD-EF:01:23:45", 17), "");
+static_assert(!MAC48::isValid("AB:CD:EF:01:23:45:", 18), "");
+
+static const MAC48 _flash[] PROGMEM = {"0:8:ab:cd:0:3"_mac,
+                                       "AB-CD-EF-01-23-45"_mac};
+
+TEST_GROUP(mac48_literal) {
+  CHECK(MAC48::read_P(&_flash[1]) == MAC48{0xABCDEF012345ull});
+
+  // the same grammar as the run time parser
+  const char *const addresses[]{"AB:CD:EF:01:23:45", ":::::",  "1:2:3:4:5",
+                                "ABC:1:2:3:4:5",     "G:::::", "1-2:3:4:5:6",
+                                "1:2:3:4:5:6:",      "::::::"};
+  for (const char *address : addresses) {
+    uint8_t octets[6];
+    const bool valid = MACAddressParser::parse(address, octets) ==
+                       MACAddressParser::Status::OK;
+    CHECK(MAC48::isValid(address, strlen(address)) == valid);
+    if (valid)
+      CHECK(MAC48::literal(address, strlen(address)) ==
+            MAC48::fromOctets(octets));
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ *      @file: test_macaddress.cpp
+ *
+ * MACAddress: construction, parsing, formatting, comparison and extension id
+ * arithmetic.
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+
+TEST_GROUP(macaddress) {
+  // construction
+  const MACAddress none;
+  CHECK(none == "DE:AD:BE:EF:FE:ED");
+  const MACAddress invalid{"FF:FF:FF:FF:FF:FF"};
+
+  uint8_t octets[6]{0x01, 0xC0, 0xFF, 0xEE, 0x4D, 0xAD};
+  const MACAddress from_octets{octets};
+  CHECK(from_octets == octets);
+  CHECK(from_octets == "01:C0:FF:EE:4D:AD");
+
+  const MACAddress from_ints{0xFE, 0xED, 0xD0, 0xD0, 0xBA, 0xBE};
+  CHECK(from_ints == "FE:ED:D0:D0:BA:BE");
+  const MACAddress out_of_range{0xFE, 0xED, 0xD0, 0xD0, 0xBA, 0x100};
+  CHECK(out_of_range == invalid);
+
+  const MACAddress from_string{String{"a0:B0:c0:D0:e0:F0"}};
+  CHECK(from_string == "A0:B0:C0:D0:E0:F0");
+
+  // parsing
+  MACAddress mac;
+  CHECK(mac.fromString("AB-CD-EF-01-23-45"));
+  CHECK(mac == "AB:CD:EF:01:23:45");
+  CHECK(mac.fromString("8::12:34:56:78"));
+  CHECK(mac == "08:00:12:34:56:78");
+  CHECK(mac.fromString(":::::1"));
+  CHECK(mac == "00:00:00:00:00:01");
+  CHECK(!mac.fromString("AB:CD:EF:01:23"));
+  CHECK(mac == invalid);
+  CHECK(mac.fromString("AB:CD:EF:01:23:456")); // "456" == "6"
+  CHECK(mac == "AB:CD:EF:01:23:06");
+  CHECK(!mac.fromString("AB:CD:EF:01:23:4G"));
+
+  // formatting
+  MACAddress formatted{0xAB, 0xCD, 0xEF, 0x01, 0x02, 0x00};
+  CHECK(strcmp(formatted.c_str(), "AB:CD:EF:01:02:00") == 0);
+  CHECK(strcmp(formatted.c_str(Representation::EUI48), "AB-CD-EF-01-02-00") ==
+        0);
+  CHECK(strcmp(formatted.c_str(Representation::COMMON_COMPACT),
+               "AB:CD:EF:1:2:") == 0);
+
+  // round trip of every representation
+  const Representation representations[]{Representation::COMMON_FULL,
+                                         Representation::EUI48,
+                                         Representation::COMMON_COMPACT};
+  for (uint8_t r = 0; r != 3; ++r)
+    for (int octet = 0; octet != 256; ++octet) {
+      MACAddress original{octet, 0, 0x0F, octet ^ 0xFF, 0x10, octet};
+      MACAddress parsed{original.c_str(representations[r])};
+      CHECK(parsed == original);
+    }
+
+  // comparison
+  CHECK(from_ints != from_octets);
+  CHECK(from_octets < from_ints);
+  CHECK(from_ints >= from_octets);
+
+  // extension id arithmetic, wrapping within the block
+  MACAddress l{"AB:CD:EF:FF:FF:FE"};
+  ++l;
+  CHECK(l == "AB:CD:EF:FF:FF:FF");
+  ++l;
+  CHECK(l == "AB:CD:EF:00:00:00");
+  --l;
+  CHECK(l == "AB:CD:EF:FF:FF:FF");
+  l += 0x10;
+  CHECK(l == "AB:CD:EF:00:00:0F");
+  l -= -1;
+  CHECK(l == "AB:CD:EF:00:00:10");
+  CHECK(l.getOUI24() == 0xABCDEF);
+  CHECK(l.getExtensionId24() == 0x10);
+  l.setExtensionId24(0x123456);
+  CHECK(l == "AB:CD:EF:12:34:56");
+}
+
+TEST_GROUP(macaddress_compare) {
+  // comparing with a string gives the result of comparing with a temporary
+  // address built from it (an invalid string standing for FF:FF:...:FF)
+  const char *const strings[]{"AB:CD:EF:01:23:45", "ab-cd-ef-1-23-45",
+                              "AB:CD:EF:01:23:46", "AB:CD:EF:01:23",
+                              "AB:CD:EF:01:23:45:", "FF:FF:FF:FF:FF:FF",
+                              "ff-ff-ff-ff-ff-ff", "AB:CD:EF:01:23:4G",
+                              "", ":::::", "0:0:0:0:0:0", "AB:CD:EF:01:23:45 "};
+  const MACAddress addresses[]{MACAddress{"AB:CD:EF:01:23:45"},
+                              MACAddress{"FF:FF:FF:FF:FF:FF"},
+                              MACAddress{"00:00:00:00:00:00"},
+                              MACAddress{"AB:CD:EF:01:23:46"}};
+  for (const MACAddress &mac : addresses)
+    for (const char *string : strings) {
+      const bool expected = mac == MACAddress{string};
+      CHECK((mac == string) == expected);
+      CHECK((mac != string) == !expected);
+      CHECK((mac == String{string}) == expected);
+      char copy[32];
+      strcpy(copy, string);
+      CHECK((mac == copy) == expected);
+    }
+  CHECK(addresses[0] == F("ab:cd:ef:01:23:45"));
+  CHECK(addresses[1] == F("not an address"));
+  CHECK(addresses[3] != F("AB:CD:EF:01:23:45"));
+}
@@ -0,0 +1,86 @@
+/*
+ *      @file: test_map.cpp
+ *
+ * MACAddressMap / MACAddressSet and their fixed variants against std::map.
+ */
+
+#include "test.h"
+
+#include <MACAddressMap.h>
+
+#include <map>
+
+// Keys of a few blocks, so that sequential ids collide and erasures shift
+static MAC48 _key(uint32_t &x) {
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return MAC48{static_cast<uint64_t>(x % 3) << 24 | (x >> 20)};
+}
+
+TEST_GROUP(map) {
+  MACAddressMap<uint32_t> map;
+  std::map<uint64_t, uint32_t> expected;
+  uint32_t x{0x12345678};
+  for (uint32_t i = 0; i != 100000; ++i) {
+    const MAC48 key = _key(x);
+    if (x & 0x400) {
+      CHECK(map.erase(key) == (expected.erase(key.value()) == 1));
+    } else {
+      map[key] += i;
+      expected[key.value()] += i;
+    }
+  }
+  CHECK(map.size() == expected.size());
+  bool same{true};
+  for (const auto &entry : expected) {
+    const uint32_t *value = map.find(MAC48{entry.first});
+    same = same && value != nullptr && *value == entry.second;
+  }
+  CHECK(same);
+  size_t visited{0};
+  map.forEach([&](MAC48 key, uint32_t &value) {
+    ++visited;
+    CHECK(expected[key.value()] == value);
+  });
+  CHECK(visited == expected.size());
+
+  // copies are independent
+  MACAddressMap<uint32_t> copy{map};
+  MACAddressMap<uint32_t> assigned;
+  assigned = map;
+  map.clear();
+  CHECK(map.empty() && map.find(MAC48{expected.begin()->first}) == nullptr);
+  CHECK(copy.size() == expected.size() && assigned.size() == expected.size());
+  CHECK(*copy.find(MAC48{expected.begin()->first}) ==
+        expected.begin()->second);
+}
+
+TEST_GROUP(map_fixed) {
+  MACAddressFixedMap<uint16_t, 64> map;
+  CHECK(map.capacity() == 48);
+  for (uint16_t i = 0; i != 48; ++i)
+    CHECK(map.insert(MAC48{0x0A0000000000ull + i}, i));
+  CHECK(!map.insert(MAC48{0x0A0000000000ull + 48}, 48)); // full
+  CHECK(map.insert(MAC48{0x0A0000000000ull + 7}, 70));   // existing key
+  CHECK(*map.find(MAC48{0x0A0000000000ull + 7}) == 70);
+
+  // erasures keep every other key reachable
+  for (uint16_t i = 0; i < 48; i += 3)
+    CHECK(map.erase(MAC48{0x0A0000000000ull + i}));
+  bool found{true};
+  for (uint16_t i = 0; i != 48; ++i)
+    found = found && (map.find(MAC48{0x0A0000000000ull + i}) != nullptr) ==
+                         (i % 3 != 0);
+  CHECK(found);
+  CHECK(map.size() == 32);
+
+  MACAddressFixedSet<16> set;
+  for (uint64_t i = 0; i != 12; ++i)
+    CHECK(set.insert(MAC48{i << 24}));
+  CHECK(!set.insert(MAC48{12ull << 24}));
+  CHECK(set.insert(MAC48{0}));
+  CHECK(set.contains(MAC48{11ull << 24}) && !set.contains(MAC48{1}));
+  MACAddressFixedSet<16> copy{set};
+  CHECK(copy.erase(MAC48{0}) && set.contains(MAC48{0}));
+}
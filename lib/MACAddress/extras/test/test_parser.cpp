@@ -0,0 +1,109 @@
+/*
+ *      @file: test_parser.cpp
+ *
+ * MACAddressParser: the grammar of NUL terminated addresses and the
+ * notations of length-delimited buffers.
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+#include <MACAddressParser.h>
+
+typedef MACAddressParser::Status Status;
+
+static bool _parsed(const char address[], uint8_t a, uint8_t b, uint8_t c,
+                    uint8_t d, uint8_t e, uint8_t f) {
+  uint8_t octets[6];
+  const uint8_t expected[6]{a, b, c, d, e, f};
+  return MACAddressParser::parse(address, octets) == Status::OK &&
+         memcmp(octets, expected, sizeof(octets)) == 0;
+}
+
+static Status _status(const char address[]) {
+  uint8_t octets[6];
+  return MACAddressParser::parse(address, octets);
+}
+
+TEST_GROUP(parser) {
+  CHECK(_parsed("AB:CD:EF:01:23:45", 0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45));
+  CHECK(_parsed("ab-cd-ef-01-23-45", 0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45));
+  CHECK(_parsed("A:A:A:A:A:B", 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0B));
+  CHECK(_parsed("40::C:0F:FE:E5", 0x40, 0x00, 0x0C, 0x0F, 0xFE, 0xE5));
+  CHECK(_parsed(":::::", 0, 0, 0, 0, 0, 0));
+  CHECK(_parsed("--1---", 0, 0, 1, 0, 0, 0));
+  // groups longer than two digits keep their trailing digits
+  CHECK(_parsed("ABC:ABCD:0:0:0:0", 0x0C, 0xCD, 0, 0, 0, 0));
+
+  CHECK(_status("") == Status::TOO_FEW_SEPARATORS);
+  CHECK(_status("AB:CD:EF:01:23") == Status::TOO_FEW_SEPARATORS);
+  CHECK(_status("AB:CD:EF:01:23:45:") == Status::TOO_MANY_SEPARATORS);
+  CHECK(_status("AB:CD:EF:01:23:45:67") == Status::TOO_MANY_SEPARATORS);
+  CHECK(_status("AB:CD-EF:01:23:45") != Status::OK); // mixed separators
+  CHECK(_status("AB:CD:EF:01:23:4G") == Status::BAD_CHAR);
+  CHECK(_status("AB:CD:EF:01:23:45 ") == Status::BAD_CHAR);
+  CHECK(_status(" AB:CD:EF:01:23:45") == Status::BAD_CHAR);
+  CHECK(_status("AB.CD.EF.01.23.45") == Status::BAD_CHAR);
+
+  // every octet value, with and without leading zeros
+  for (int octet = 0; octet != 256; ++octet) {
+    char address[32];
+    snprintf(address, sizeof(address), "%x:%X:%02x:%02X:0:%x", octet, octet,
+             octet, octet, octet);
+    CHECK(_parsed(address, static_cast<uint8_t>(octet),
+                  static_cast<uint8_t>(octet), static_cast<uint8_t>(octet),
+                  static_cast<uint8_t>(octet), 0,
+                  static_cast<uint8_t>(octet)));
+  }
+  // every character in place of a digit
+  for (int c = 1; c != 256; ++c) {
+    char address[]{"AB:CD:EF:01:23:4?"};
+    address[16] = static_cast<char>(c);
+    uint8_t nibble;
+    const bool digit = MACAddressParser::hexToNibble(static_cast<char>(c),
+                                                     nibble);
+    CHECK((_status(address) == Status::OK) == digit);
+  }
+}
+
+// Parses buffer (length characters, not NUL terminated) and checks the
+// characters consumed, the notation found and the octets.
+static bool _sliced(const char buffer[], size_t length, size_t consumed,
+                    Notation notation) {
+  const uint8_t expected[6]{0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+  uint8_t octets[6]{};
+  Notation found{Notation::COLON};
+  const size_t rc = MACAddressParser::parse(buffer, length, octets, &found);
+  return rc == consumed && found == notation &&
+         (rc == 0 || memcmp(octets, expected, sizeof(octets)) == 0);
+}
+
+TEST_GROUP(parser_buffer) {
+  // every notation, followed by other characters not read
+  CHECK(_sliced("AB:CD:EF:01:23:45,", 18, 17, Notation::COLON));
+  CHECK(_sliced("ab-cd-ef-01-23-45\"", 18, 17, Notation::DASH));
+  CHECK(_sliced("abcd.ef01.2345 ", 15, 14, Notation::DOTTED));
+  CHECK(_sliced("ABCDEF012345}", 13, 12, Notation::BARE));
+
+  // the length ends the input: the characters after it are never read
+  CHECK(_sliced("AB:CD:EF:01:23:456789", 17, 17, Notation::COLON));
+  CHECK(_sliced("abcd.ef01.23456789", 14, 14, Notation::DOTTED));
+  CHECK(_sliced("ABCDEF0123456", 12, 12, Notation::BARE));
+  uint8_t octets[6];
+  CHECK(MACAddressParser::parse("AB:CD:EF:01:23:45", 16, octets) == 16);
+  CHECK(octets[5] == 0x04);
+
+  // not addresses: nothing consumed, the octets untouched
+  CHECK(_sliced("AB:CD:EF:01:23", 14, 0, Notation::NONE));
+  CHECK(_sliced("ABCDEF01234", 11, 0, Notation::NONE));
+  CHECK(_sliced("ABCDEF0123456", 13, 0, Notation::NONE));
+  CHECK(_sliced("abcd.ef01.2345a", 15, 0, Notation::NONE));
+  CHECK(_sliced("abc.def0.1234", 13, 0, Notation::NONE));
+  CHECK(_sliced("", 0, 0, Notation::NONE));
+
+  MACAddress mac;
+  CHECK(mac.parse("abcd.ef01.2345", 14) == 14);
+  CHECK(mac == "AB:CD:EF:01:23:45");
+  CHECK(mac.parse("abcd.ef01", 9) == 0);
+  CHECK(mac == "FF:FF:FF:FF:FF:FF");
+}
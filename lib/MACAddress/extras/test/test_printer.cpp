@@ -0,0 +1,72 @@
+/*
+ *      @file: test_printer.cpp
+ *
+ * Printing: a single write per address and MACAddressPrinter buffering.
+ */
+
+#include "test.h"
+
+#include <MACAddressPrinter.h>
+
+#include <string>
+
+// Print sink recording the text and the number of write calls
+class RecordingPrint : public Print {
+public:
+  std::string text;
+  unsigned long writes{0};
+
+  virtual size_t write(uint8_t c) {
+    ++writes;
+    text.push_back(static_cast<char>(c));
+    return 1;
+  }
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    ++writes;
+    text.append(reinterpret_cast<const char *>(buffer), size);
+    return size;
+  }
+  using Print::write;
+};
+
+TEST_GROUP(printer) {
+  const MACAddress mac{0xAB, 0xCD, 0xEF, 0x01, 0x02, 0x00};
+
+  RecordingPrint single;
+  CHECK(mac.printTo(single) == 17);
+  CHECK(single.text == "AB:CD:EF:01:02:00" && single.writes == 1);
+  single.text.clear();
+  CHECK(single.print(mac.as(Representation::COMMON_COMPACT)) == 13);
+  CHECK(single.text == "AB:CD:EF:1:2:" && single.writes == 2);
+
+  // buffered: one write per full buffer and one on flush
+  RecordingPrint sink;
+  std::string expected;
+  const size_t count{200};
+  {
+    MACAddressPrinter printer{sink, Representation::EUI48, ','};
+    for (size_t i = 0; i != count; ++i) {
+      const MAC48 value{0x0008AB000000ull + i};
+      char text[MAC48::str_size];
+      expected += value.toString(text, Representation::EUI48);
+      expected += ',';
+      CHECK(printer.print(value) == 18);
+    }
+    CHECK(sink.writes == count * 18 / MACADDRESS_PRINTER_BUFFER);
+  } // flushed on destruction
+  CHECK(sink.text == expected);
+  CHECK(sink.writes == (count * 18 + MACADDRESS_PRINTER_BUFFER - 1) /
+                           MACADDRESS_PRINTER_BUFFER);
+
+  // packed arrays and octets give the same text
+  uint8_t octets[3 * 6];
+  for (uint8_t i = 0; i != 3; ++i)
+    MAC48{0x0008AB000000ull + i}.toOctets(octets + 6 * i);
+  RecordingPrint packed;
+  MACAddressPrinter printer{packed, Representation::EUI48, ','};
+  CHECK(printer.print(octets, 2) == 36);
+  CHECK(printer.print(octets + 12) == 18);
+  CHECK(printer.flush() == 54);
+  CHECK(packed.text == expected.substr(0, 54));
+  CHECK(printer.flush() == 0);
+}
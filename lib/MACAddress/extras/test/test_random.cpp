@@ -0,0 +1,110 @@
+/*
+ *      @file: test_random.cpp
+ *
+ * MACAddressRandom: unique addresses within the prefix, with the I/G and U/L
+ * bits it asks for.
+ */
+
+#include "test.h"
+
+#include <MACAddressBatch.h>
+#include <MACAddressRandom.h>
+
+#include <set>
+#include <vector>
+
+// Generates the whole space of random, checking every address against
+// prefix: false on a repeated address or one outside prefix
+static bool _exhaust(MACAddressRandom &random, const MACAddressPrefix &prefix,
+                     bool multicast, bool local) {
+  std::set<uint64_t> seen;
+  bool ok{true};
+  MAC48 mac;
+  while (random.next(mac))
+    ok = ok && seen.insert(mac.value()).second && prefix.matches(mac) &&
+         mac.isMulticast() == multicast && mac.isLocal() == local;
+  return ok && seen.size() == random.size() && random.remaining() == 0;
+}
+
+TEST_GROUP(random) {
+  // a 36 bits prefix: 4096 addresses
+  const MACAddressPrefix oui36{"0A:1B:2C:3D:40:00"_mac, 36};
+  MACAddressRandom small{42, oui36};
+  CHECK(small.isValid() && small.size() == 4096);
+  CHECK(_exhaust(small, oui36, false, true));
+  MAC48 mac;
+  CHECK(!small.next(mac) && small.generate(&mac, 1) == 0);
+
+  // a universal prefix keeps its U/L bit, a group one its I/G bit
+  const MACAddressPrefix universal{"00:08:AB:CD:E0:00"_mac, 36};
+  MACAddressRandom vendor{7, universal};
+  CHECK(_exhaust(vendor, universal, false, false));
+  const MACAddressPrefix group{"01:00:5E:7F:F0:00"_mac, 36};
+  MACAddressRandom multicast{7, group};
+  CHECK(_exhaust(multicast, group, true, false));
+
+  // free bits in two runs (bits 8 to 15 and 24 to 31)
+  const MACAddressPrefix scattered{"02:11:00:22:00:33"_mac,
+                                   "FF:FF:00:FF:00:FF"_mac};
+  MACAddressRandom runs{1, scattered};
+  CHECK(runs.isValid() && runs.size() == 65536);
+  CHECK(_exhaust(runs, scattered, false, true));
+
+  // no prefix: 46 free bits, unicast and locally administered
+  MACAddressRandom random{2024};
+  CHECK(random.size() == 1ull << 46);
+  std::set<uint64_t> seen;
+  bool ok{true};
+  for (unsigned i = 0; i != 100000 && random.next(mac); ++i)
+    ok = ok && seen.insert(mac.value()).second && mac.isUnicast() &&
+         mac.isLocal();
+  CHECK(ok && seen.size() == 100000);
+  CHECK(random.remaining() == random.size() - 100000);
+}
+
+TEST_GROUP(random_invalid) {
+  // free bits in six runs: nothing is generated
+  MACAddressRandom random{3, MACAddressPrefix{"02:00:00:00:00:00"_mac,
+                                              "F0:F0:F0:F0:F0:F0"_mac}};
+  CHECK(!random.isValid());
+  CHECK(random.size() == 0 && random.remaining() == 0);
+  MAC48 mac;
+  MACAddress address;
+  uint8_t octets[MACAddressBatch::octets_size];
+  CHECK(!random.next(mac) && !random.next(address));
+  CHECK(random.generate(&mac, 1) == 0 && random.generate(octets, 1) == 0);
+
+  // a prefix fixing every bit holds a single address
+  MACAddressRandom single{3, MACAddressPrefix{"02:00:00:00:00:01"_mac, 48}};
+  CHECK(single.isValid() && single.size() == 1);
+  CHECK(single.next(mac) && mac == "02:00:00:00:00:01"_mac);
+  CHECK(!single.next(mac));
+}
+
+// The same seed gives the same sequence, whichever the output
+TEST_GROUP(random_batch) {
+  const size_t count{10007};
+  MACAddressRandom scalar{99}, batch{99}, packed{99}, other{100};
+  std::vector<MAC48> expected(count), macs(count), others(count);
+  bool generated{true};
+  for (size_t i = 0; i != count; ++i)
+    generated = generated && scalar.next(expected[i]);
+  CHECK(generated);
+  CHECK(batch.generate(macs.data(), 10) == 10);
+  CHECK(batch.generate(macs.data() + 10, count - 10) == count - 10);
+  CHECK(macs == expected);
+
+  std::vector<uint8_t> octets(count * MACAddressBatch::octets_size);
+  CHECK(packed.generate(octets.data(), 3) == 3);
+  CHECK(packed.generate(octets.data() + 3 * MACAddressBatch::octets_size,
+                        count - 3) == count - 3);
+  bool same{true};
+  for (size_t i = 0; i != count; ++i)
+    same = same &&
+           MAC48::fromOctets(&octets[i * MACAddressBatch::octets_size]) ==
+               expected[i];
+  CHECK(same);
+
+  CHECK(other.generate(others.data(), count) == count);
+  CHECK(others != expected);
+}
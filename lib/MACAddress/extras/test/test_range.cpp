@@ -0,0 +1,83 @@
+/*
+ *      @file: test_range.cpp
+ *
+ * MACAddressRange against the walk of MACAddress::operator++, wrapping
+ * around the extension id of its block.
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+#include <MACAddressBatch.h>
+#include <MACAddressRange.h>
+
+#include <iterator>
+#include <vector>
+
+TEST_GROUP(range) {
+  const MA sets[]{MA::L, MA::M, MA::S};
+  for (MA ma : sets) {
+    // from 100 addresses before the end of the block on: it wraps around
+    const uint64_t mask = MAC48::extensionIdMask(ma);
+    const MAC48 first = "AB:CD:EF:12:34:56"_mac.withExtensionId(ma, mask - 99);
+    const size_t count{250};
+    const MACAddressRange range{first, count, ma};
+    CHECK(range.size() == count && !range.empty());
+
+    std::vector<MAC48> walked;
+    MACAddress mac{first};
+    mac.ma = ma;
+    for (size_t i = 0; i != count; ++i, ++mac)
+      walked.push_back(mac.toMAC48());
+
+    std::vector<MAC48> iterated(range.begin(), range.end());
+    CHECK(iterated == walked);
+    CHECK(range[100] == first.withExtensionId(ma, 0));
+    CHECK(range[count - 1] == walked.back());
+
+    std::vector<MAC48> filled(count);
+    CHECK(range.fill(filled.data()) == count);
+    CHECK(filled == walked);
+    std::vector<uint8_t> octets(count * MACAddressBatch::octets_size);
+    CHECK(range.fill(octets.data()) == count);
+    bool packed{true};
+    for (size_t i = 0; i != count; ++i)
+      packed = packed &&
+               MAC48::fromOctets(&octets[i * MACAddressBatch::octets_size]) ==
+                   walked[i];
+    CHECK(packed);
+
+    CHECK(range.contains(first) && range.contains(walked.back()));
+    CHECK(!range.contains(first.withExtensionId(ma, 150)));
+    CHECK(!range.contains(first.withExtensionId(ma, mask - 100)));
+    CHECK(!range.contains(MAC48{first.value() ^ 0x800000000000ull}));
+
+    // the same range from its bounds, and split in chunks
+    const MACAddressRange bounded{first, MAC48{walked.back().value() + 1}, ma};
+    CHECK(std::vector<MAC48>(bounded.begin(), bounded.end()) == walked);
+    std::vector<MAC48> chunks;
+    for (uint64_t k = 0; k < count; k += 64) {
+      const MACAddressRange chunk{range.begin() + k,
+                                  range.begin() + (k + 64 < count ? k + 64
+                                                                  : count)};
+      chunks.insert(chunks.end(), chunk.begin(), chunk.end());
+    }
+    CHECK(chunks == walked);
+
+    const MACAddressRange block = MACAddressRange::block(first, ma);
+    CHECK(block.size() == mask + 1);
+    CHECK(block[0] == first.withExtensionId(ma, 0));
+    CHECK(MACAddressRange(first, block.size() + 5, ma).size() == block.size());
+  }
+
+  const MACAddressRange range{"00:08:AB:00:00:10"_mac, 10};
+  MACAddressRange::iterator it = range.begin();
+  CHECK(std::distance(range.begin(), range.end()) == 10);
+  CHECK(*(it + 3) == "00:08:AB:00:00:13"_mac && it[9] == *(range.end() - 1));
+  CHECK(*it++ == "00:08:AB:00:00:10"_mac && *it == "00:08:AB:00:00:11"_mac);
+  CHECK(*--it == "00:08:AB:00:00:10"_mac && it < range.end());
+  CHECK(MACAddressRange(range.end(), range.begin()).empty());
+  CHECK(MACAddressRange("00:08:AB:00:00:10"_mac, "00:08:AB:00:00:10"_mac)
+            .empty());
+  CHECK(MACAddressRange().empty());
+}
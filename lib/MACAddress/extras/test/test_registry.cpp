@@ -0,0 +1,67 @@
+/*
+ *      @file: test_registry.cpp
+ *
+ * MACAddressRegistry: compilation of registry CSV files and longest-prefix
+ * lookups.
+ */
+
+#include "test.h"
+
+#include <MACAddressRegistry.h>
+
+#ifdef MACADDRESS_HAS_MMAP
+
+static bool _write(const char *path, const char *text) {
+  FILE *file = fopen(path, "wb");
+  if (file == nullptr)
+    return false;
+  const bool ok = fputs(text, file) >= 0;
+  return fclose(file) == 0 && ok;
+}
+
+TEST_GROUP(registry) {
+  const char *oui = test::path("oui.csv");
+  const char *mam = test::path("mam.csv");
+  const char *oui36 = test::path("oui36.csv");
+  const char *bin = test::path("oui.bin");
+  CHECK(_write(oui, "Registry,Assignment,Organization Name,Organization "
+                    "Address\r\n"
+                    "MA-L,00005E,ICANN,\"Street, City\"\r\n"
+                    "MA-L,0008AB,\"Vendor \"\"A\"\"\",Somewhere\r\n"
+                    "MA-L,FCFFFF,Last,\r\n"));
+  CHECK(_write(mam, "Registry,Assignment,Organization Name\n"
+                    "MA-M,0008AB1,Vendor M,\n"
+                    "MA-M,70B3D50,Below no MA-L,\n"));
+  CHECK(_write(oui36, "Registry,Assignment,Organization Name\n"
+                      "MA-S,0008AB1F0,Vendor S,\n"));
+
+  const char *const csvs[]{oui, mam, oui36};
+  CHECK(MACAddressRegistry::compile(csvs, 3, bin) == 6);
+
+  MACAddressRegistry registry;
+  CHECK(registry.open(bin));
+  CHECK(registry.size() >= 6);
+
+  uint8_t bits{0};
+  const char *name = registry.lookup("00:00:5E:00:53:01"_mac, &bits);
+  CHECK(name != nullptr && strcmp(name, "ICANN") == 0 && bits == 24);
+  name = registry.lookup("00:08:AB:00:00:01"_mac, &bits);
+  CHECK(name != nullptr && strcmp(name, "Vendor \"A\"") == 0 && bits == 24);
+  name = registry.lookup("00:08:AB:1A:00:01"_mac, &bits);
+  CHECK(name != nullptr && strcmp(name, "Vendor M") == 0 && bits == 28);
+  name = registry.lookup("00:08:AB:1F:01:02"_mac, &bits);
+  CHECK(name != nullptr && strcmp(name, "Vendor S") == 0 && bits == 36);
+  name = registry.lookup("70:B3:D5:0F:FF:FF"_mac, &bits);
+  CHECK(name != nullptr && strcmp(name, "Below no MA-L") == 0 && bits == 28);
+  CHECK(registry.lookup("70:B3:D5:10:00:00"_mac) == nullptr);
+  name = registry.lookup("FC:FF:FF:FF:FF:FF"_mac);
+  CHECK(name != nullptr && strcmp(name, "Last") == 0);
+  CHECK(registry.lookup("00:00:00:00:00:00"_mac) == nullptr);
+
+  // not a registry
+  MACAddressRegistry other;
+  CHECK(!other.open(oui));
+  CHECK(!other.isOpen() && other.lookup("00:00:5E:00:53:01"_mac) == nullptr);
+}
+
+#endif // MACADDRESS_HAS_MMAP
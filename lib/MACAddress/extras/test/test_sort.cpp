@@ -0,0 +1,104 @@
+/*
+ *      @file: test_sort.cpp
+ *
+ * MACAddressSort against std::sort, std::unique and the std::set_ algorithms.
+ */
+
+#include "test.h"
+
+#include <MACAddressSort.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+// Addresses of a few vendors, with duplicates
+static std::vector<MAC48> _addresses(size_t count, uint64_t seed) {
+  std::vector<MAC48> rc(count);
+  for (size_t i = 0; i != count; ++i) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    const uint64_t x = seed >> 16;
+    rc[i] = MAC48{(x % 5 == 0 ? x : (x % 3) << 40 | (x & 0xFFFFF))};
+  }
+  return rc;
+}
+
+static std::vector<uint8_t> _packed(const std::vector<MAC48> &values) {
+  std::vector<uint8_t> rc(values.size() * 6);
+  for (size_t i = 0; i != values.size(); ++i)
+    values[i].toOctets(&rc[i * 6]);
+  return rc;
+}
+
+TEST_GROUP(sort) {
+  // below and above the size sorted within the caches
+  const size_t sizes[]{0, 1, 2, 100, 5000, 100000};
+  for (size_t count : sizes) {
+    std::vector<MAC48> values = _addresses(count, count);
+    std::vector<uint8_t> octets = _packed(values);
+    std::vector<MAC48> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<MAC48> scratch(count);
+    MACAddressSort::sort(values.data(), count, scratch.data());
+    CHECK(values == expected);
+
+    std::vector<uint8_t> packed_scratch(octets.size());
+    MACAddressSort::sort(octets.data(), count, packed_scratch.data());
+    CHECK(octets == _packed(expected));
+
+#ifdef MACADDRESS_HAS_THREAD
+    std::vector<MAC48> parallel = _addresses(count, count);
+    MACAddressSort::sortParallel(parallel.data(), count, scratch.data(), 4);
+    CHECK(parallel == expected);
+#endif
+
+    const size_t n = MACAddressSort::unique(values.data(), count);
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+    CHECK(std::vector<MAC48>(values.begin(), values.begin() + n) ==
+          expected);
+    CHECK(MACAddressSort::unique(octets.data(), count) == n);
+  }
+
+  // a single vendor (constant leading bytes) and a sorted array
+  std::vector<MAC48> vendor(70000);
+  for (size_t i = 0; i != vendor.size(); ++i)
+    vendor[i] = MAC48{0x0008AB000000ull | ((i * 7919) & 0xFFFF)};
+  std::vector<MAC48> expected = vendor;
+  std::sort(expected.begin(), expected.end());
+  std::vector<MAC48> scratch(vendor.size());
+  MACAddressSort::sort(vendor.data(), vendor.size(), scratch.data());
+  CHECK(vendor == expected);
+  MACAddressSort::sort(vendor.data(), vendor.size(), scratch.data());
+  CHECK(vendor == expected);
+}
+
+TEST_GROUP(sort_sets) {
+  std::vector<MAC48> a = _addresses(3000, 1), b = _addresses(2000, 2);
+  b.insert(b.end(), a.begin(), a.begin() + 500);
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+
+  std::vector<MAC48> expected, out(a.size());
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(expected));
+  size_t n = MACAddressSort::intersection(a.data(), a.size(), b.data(),
+                                          b.size(), out.data());
+  CHECK(std::vector<MAC48>(out.begin(), out.begin() + n) == expected);
+  CHECK(n >= 500);
+
+  expected.clear();
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::back_inserter(expected));
+  n = MACAddressSort::difference(a.data(), a.size(), b.data(), b.size(),
+                                 out.data());
+  CHECK(std::vector<MAC48>(out.begin(), out.begin() + n) == expected);
+
+  // packed, in place
+  std::vector<uint8_t> pa = _packed(a), pb = _packed(b);
+  n = MACAddressSort::difference(pa.data(), a.size(), pb.data(), b.size(),
+                                 pa.data());
+  pa.resize(n * 6);
+  CHECK(pa == _packed(expected));
+}
@@ -0,0 +1,93 @@
+/*
+ *      @file: test_stats.cpp
+ *
+ * MACAddressStats counters (all zeros unless built with MACADDRESS_STATS).
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+#include <MACAddressStats.h>
+
+#include <thread>
+#include <vector>
+
+TEST_GROUP(stats) {
+  MACAddressStats::reset();
+
+  uint8_t octets[6];
+  MACAddressParser::parse("AB:CD:EF:01:23:45", octets);
+  MACAddressParser::parse("AB:CD:EF:01:23:4G", octets);
+  MACAddressParser::parse("AB:CD:EF:01:23", octets);
+  char text[MACAddressFormat::size];
+  MAC48 mac{"AB:CD:EF:FF:FF:FE"_mac};
+  mac.toChars(text, text + sizeof(text));
+  MACAddress address{mac};
+  address += 1;
+  address += 1; // wraps to AB:CD:EF:00:00:00
+  const bool equal = address == "AB:CD:EF:00:00:01";
+
+  MACAddressStats::Counters counters;
+  MACAddressStats::snapshot(counters);
+  const unsigned long on = MACAddressStats::enabled() ? 1 : 0;
+  CHECK(!equal);
+  CHECK(counters.calls[MACAddressStats::PARSE] == 3 * on);
+  CHECK(counters.calls[MACAddressStats::FORMAT] == 1 * on);
+  CHECK(counters.calls[MACAddressStats::ARITHMETIC] == 2 * on);
+  CHECK(counters.calls[MACAddressStats::COMPARE] == 1 * on);
+  CHECK(counters.failures[MACAddressStats::OK] == 0);
+  CHECK(counters.failures[MACAddressStats::BAD_CHAR] == 1 * on);
+  CHECK(counters.failures[MACAddressStats::TOO_FEW_SEPARATORS] == 1 * on);
+  CHECK(counters.failures[MACAddressStats::STOPPED] == 1 * on);
+  CHECK(counters.wraps == 1 * on);
+
+  MACAddressStats::reset();
+  MACAddressStats::snapshot(counters);
+  CHECK(counters.calls[MACAddressStats::PARSE] == 0 && counters.wraps == 0);
+}
+
+// Only the moves crossing the end of the block (either way) wrap around
+TEST_GROUP(stats_wraps) {
+  const MACAddress five{"AB:CD:EF:00:00:05"_mac};
+  MACAddressStats::reset();
+  const MACAddress down = five + (-1), up = five - (-1);
+  MACAddress across = five + (-6), back = five - 6;
+  MACAddressStats::Counters counters;
+  MACAddressStats::snapshot(counters);
+  CHECK(down == "AB:CD:EF:00:00:04" && up == "AB:CD:EF:00:00:06");
+  CHECK(across == "AB:CD:EF:FF:FF:FF" && across == back);
+  CHECK(counters.wraps == (MACAddressStats::enabled() ? 2 : 0));
+
+  // whole turns of the block (-INT64_MIN does not fit an int64_t)
+  across += INT64_MIN;
+  back -= INT64_MIN;
+  CHECK(across == "AB:CD:EF:FF:FF:FF" && back == across);
+  across.ma = MA::S;
+  across -= 0x1000000000ll + 1;
+  CHECK(across == "AB:CD:EF:FF:FF:FE");
+  MACAddressStats::snapshot(counters);
+  CHECK(counters.wraps == (MACAddressStats::enabled() ? 5 : 0));
+}
+
+// Concurrent threads lose no count
+TEST_GROUP(stats_threads) {
+  const unsigned threads{4};
+  const unsigned long parses{50000};
+  MACAddressStats::reset();
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t != threads; ++t)
+    workers.emplace_back([parses] {
+      uint8_t octets[6];
+      for (unsigned long i = 0; i != parses; ++i)
+        MACAddressParser::parse("AB:CD:EF:01:23:4G", octets);
+    });
+  for (std::thread &worker : workers)
+    worker.join();
+
+  MACAddressStats::Counters counters;
+  MACAddressStats::snapshot(counters);
+  const unsigned long expected = MACAddressStats::enabled() ? threads * parses
+                                                            : 0;
+  CHECK(counters.calls[MACAddressStats::PARSE] == expected);
+  CHECK(counters.failures[MACAddressStats::BAD_CHAR] == expected);
+}
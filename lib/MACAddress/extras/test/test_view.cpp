@@ -0,0 +1,40 @@
+/*
+ *      @file: test_view.cpp
+ *
+ * MACAddressView: reads in place, agreeing with MACAddress and MAC48.
+ */
+
+#include "test.h"
+
+#include <MACAddress.h>
+
+#include <string>
+
+TEST_GROUP(view) {
+  // destination (broadcast), source, ethertype
+  uint8_t frame[14]{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02,
+                    0x08, 0xAB, 0x12, 0x34, 0x56, 0x08, 0x00};
+  const MACAddressView destination{frame}, source{frame + 6};
+
+  CHECK(destination.isBroadcast() && destination.isMulticast());
+  CHECK(source.isUnicast() && source.isLocal());
+  CHECK(source.data() == frame + 6);
+  CHECK(source.getOUI24() == 0x0208AB && source.getExtensionId24() == 0x123456);
+  CHECK(source.getExtensionId(MA::S) == 0x8AB123456ull);
+  CHECK(source == MAC48{0x0208AB123456ull});
+  CHECK(source < destination && destination != source);
+
+  const MACAddress gateway{"02:08:AB:12:34:56"};
+  CHECK(gateway == source);
+  CHECK(gateway.toMAC48() == source.toMAC48());
+
+  char text[MACAddressFormat::size];
+  CHECK(std::string(text, source.toChars(text, text + sizeof(text),
+                                         Representation::EUI48)) ==
+        "02-08-AB-12-34-56");
+
+  // nothing is copied: the view follows the bytes
+  frame[11] = 0x57;
+  CHECK(source == MAC48{0x0208AB123457ull});
+  CHECK(gateway != source);
+}
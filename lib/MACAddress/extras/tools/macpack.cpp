@@ -0,0 +1,93 @@
+/*
+ *      @file: macpack.cpp
+ *
+ * Converts lists of addresses (one per line) to and from MACAddressArchive
+ * files:
+ *
+ *   macaddress_pack [-c chunk] archive.mpk [list.txt]  # stdin by default
+ *   macaddress_pack -d archive.mpk                     # to stdout
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <MACAddressArchive.h>
+
+static int _unpack(const char *path) {
+  MACAddressArchive::Reader reader;
+  if (!reader.open(path)) {
+    fprintf(stderr, "%s: not an archive\n", path);
+    return 1;
+  }
+
+  MAC48 macs[1024];
+  size_t n;
+  while ((n = reader.read(macs, 1024)) != 0)
+    for (size_t i = 0; i != n; ++i) {
+      char text[MAC48::str_size];
+      puts(macs[i].toString(text));
+    }
+
+  if (reader.failed()) {
+    fprintf(stderr, "%s: corrupted chunk\n", path);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 3 && 0 == strcmp(argv[1], "-d"))
+    return _unpack(argv[2]);
+
+  uint32_t chunk{MACAddressArchive::chunk_size};
+  int i = 1;
+  if (i + 1 < argc && 0 == strcmp(argv[i], "-c")) {
+    chunk = static_cast<uint32_t>(atol(argv[i + 1]));
+    i += 2;
+  }
+  if (i != argc - 1 && i != argc - 2) {
+    fprintf(stderr,
+            "usage: %s [-c chunk] archive.mpk [list.txt]\n"
+            "       %s -d archive.mpk\n",
+            argv[0], argv[0]);
+    return 2;
+  }
+
+  FILE *input = i + 1 < argc ? fopen(argv[i + 1], "r") : stdin;
+  if (input == nullptr) {
+    fprintf(stderr, "%s: cannot be read\n", argv[i + 1]);
+    return 1;
+  }
+
+  MACAddressArchive::Writer writer{chunk};
+  if (!writer.open(argv[i])) {
+    fprintf(stderr, "%s: cannot be written\n", argv[i]);
+    return 1;
+  }
+
+  char line[256];
+  unsigned long long skipped{0};
+  MACAddress mac;
+  while (fgets(line, sizeof(line), input) != nullptr) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[0] == '\0')
+      continue;
+    if (mac.fromString(line))
+      writer.add(mac);
+    else
+      ++skipped;
+  }
+  if (input != stdin)
+    fclose(input);
+
+  const unsigned long long addresses = writer.size();
+  if (!writer.close()) {
+    fprintf(stderr, "%s: write failed\n", argv[i]);
+    return 1;
+  }
+
+  printf("%s: %llu addresses", argv[i], addresses);
+  printf(skipped != 0 ? ", %llu invalid lines skipped\n" : "\n", skipped);
+  return 0;
+}
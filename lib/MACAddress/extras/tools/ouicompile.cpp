@@ -0,0 +1,62 @@
+/*
+ *      @file: ouicompile.cpp
+ *
+ * Compiles the IEEE registry CSV files into the binary file mapped by
+ * MACAddressRegistry, or looks addresses up in a compiled one:
+ *
+ *   macaddress_ouicompile output.bin oui.csv [mam.csv oui36.csv iab.csv]
+ *   macaddress_ouicompile -l registry.bin AA:BB:CC:DD:EE:FF [...]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <MACAddress.h>
+#include <MACAddressRegistry.h>
+
+static int _lookup(int argc, char *argv[]) {
+  MACAddressRegistry registry;
+  if (!registry.open(argv[2])) {
+    fprintf(stderr, "%s: not a compiled registry\n", argv[2]);
+    return 1;
+  }
+
+  for (int i = 3; i < argc; ++i) {
+    MACAddress mac;
+    if (!mac.fromString(argv[i])) {
+      fprintf(stderr, "%s: invalid address\n", argv[i]);
+      continue;
+    }
+
+    uint8_t bits{0};
+    const char *name = registry.lookup(mac.toMAC48(), &bits);
+    if (name == nullptr)
+      printf("%s\t-\n", argv[i]);
+    else
+      printf("%s\t/%u\t%s\n", argv[i], bits, name);
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc >= 3 && 0 == strcmp(argv[1], "-l"))
+    return _lookup(argc, argv);
+
+  if (argc < 3) {
+    fprintf(stderr,
+            "usage: %s output.bin registry.csv [...]\n"
+            "       %s -l registry.bin address [...]\n",
+            argv[0], argv[0]);
+    return 2;
+  }
+
+  const size_t assignments =
+      MACAddressRegistry::compile(argv + 2, argc - 2, argv[1]);
+  if (assignments == 0) {
+    fprintf(stderr, "%s: no assignment compiled\n", argv[1]);
+    return 1;
+  }
+
+  printf("%s: %zu assignments\n", argv[1], assignments);
+  return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ *      @file: pcapstats.cpp
+ *
+ * Traffic of the addresses and OUIs found in a pcap or pcapng capture:
+ *
+ *   macaddress_pcapstats [-t threads] [-n top] [-r registry.bin] capture
+ *
+ * prints the totals and the addresses and OUIs with the most bytes (sent and
+ * received); with a registry compiled by macaddress_ouicompile the OUIs are
+ * shown with the name of their organization.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <MACAddressCapture.h>
+#include <MACAddressRegistry.h>
+
+typedef std::pair<MAC48, MACAddressTraffic> Entry;
+
+static std::vector<Entry>
+_top(const MACAddressMap<MACAddressTraffic> &table, size_t n) {
+  std::vector<Entry> entries;
+  table.forEach([&](MAC48 mac, const MACAddressTraffic &traffic) {
+    entries.push_back(Entry{mac, traffic});
+  });
+
+  auto bytes = [](const Entry &a, const Entry &b) {
+    return a.second.tx_bytes + a.second.rx_bytes >
+           b.second.tx_bytes + b.second.rx_bytes;
+  };
+  n = std::min(n, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + n, entries.end(),
+                    bytes);
+  entries.resize(n);
+  return entries;
+}
+
+static void _print(const char *title, const std::vector<Entry> &entries,
+                   const MACAddressRegistry *registry) {
+  printf("\n%-17s %12s %14s %12s %14s\n", title, "tx frames", "tx bytes",
+         "rx frames", "rx bytes");
+  for (const Entry &entry : entries) {
+    char text[MAC48::str_size];
+    const MACAddressTraffic &t = entry.second;
+    printf("%-17s %12llu %14llu %12llu %14llu", entry.first.toString(text),
+           static_cast<unsigned long long>(t.tx_frames),
+           static_cast<unsigned long long>(t.tx_bytes),
+           static_cast<unsigned long long>(t.rx_frames),
+           static_cast<unsigned long long>(t.rx_bytes));
+
+    const char *name =
+        registry != nullptr ? registry->lookup(entry.first) : nullptr;
+    printf(name != nullptr ? "  %s\n" : "\n", name);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  unsigned threads{0};
+  size_t top{10};
+  const char *registry_path{nullptr};
+
+  int i = 1;
+  for (; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+    if (0 == strcmp(argv[i], "-t"))
+      threads = static_cast<unsigned>(atoi(argv[i + 1]));
+    else if (0 == strcmp(argv[i], "-n"))
+      top = static_cast<size_t>(atol(argv[i + 1]));
+    else if (0 == strcmp(argv[i], "-r"))
+      registry_path = argv[i + 1];
+    else
+      break;
+  }
+  if (i + 1 != argc) {
+    fprintf(stderr,
+            "usage: %s [-t threads] [-n top] [-r registry.bin] capture\n",
+            argv[0]);
+    return 2;
+  }
+
+  MACAddressCapture capture;
+  if (!capture.open(argv[i])) {
+    fprintf(stderr, "%s: not a pcap or pcapng capture\n", argv[i]);
+    return 1;
+  }
+
+  MACAddressRegistry registry;
+  if (registry_path != nullptr && !registry.open(registry_path)) {
+    fprintf(stderr, "%s: not a compiled registry\n", registry_path);
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  capture.analyze(threads);
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+  printf("%llu frames, %llu bytes, %llu skipped, %zu addresses, %zu OUIs "
+         "(%.3f s)\n",
+         static_cast<unsigned long long>(capture.frames()),
+         static_cast<unsigned long long>(capture.bytes()),
+         static_cast<unsigned long long>(capture.skipped()),
+         capture.addresses().size(), capture.ouis().size(), seconds);
+
+  _print("address", _top(capture.addresses(), top), nullptr);
+  _print("OUI", _top(capture.ouis(), top),
+         registry.isOpen() ? &registry : nullptr);
+  return 0;
+}
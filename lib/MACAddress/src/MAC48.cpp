@@ -0,0 +1,50 @@
+/*
+ *      @file: MAC48.cpp
+ */
+
+#include "MAC48.h"
+
+static_assert(sizeof(MAC48) == 8, "MAC48 must fit in a 64 bits register");
+static_assert(__is_trivially_copyable(MAC48),
+              "MAC48 must be trivially copyable");
+
+// Definitions of the masks, for the callers binding them to a reference
+// (C++11 has no inline variables)
+constexpr uint64_t MAC48::mask48;
+constexpr uint64_t MAC48::ig_bit;
+constexpr uint64_t MAC48::ul_bit;
+
+/*
+    Only called by MAC48::literal() for a malformed literal evaluated at run
+    time (i.e. not in a constant expression, where the call itself is the
+    compilation error): the result is FF:FF:FF:FF:FF:FF, as for an invalid
+    string passed to MACAddress::fromString().
+ */
+void mac_literal_is_malformed(void) {}
+
+char *MAC48::toChars(char *first, char *last,
+                     Representation representation) const {
+  uint8_t octets[6];
+  char text[MACAddressFormat::size];
+
+  toOctets(octets);
+  const size_t length = static_cast<size_t>(
+      MACAddressFormat::write(text, octets, representation) - text);
+
+  if (last - first < static_cast<ptrdiff_t>(length))
+    return nullptr;
+
+  memcpy(first, text, length);
+  return first + length;
+}
+
+char *MAC48::toString(char buffer[], Representation representation) const {
+  *toChars(buffer, buffer + str_size - 1, representation) = '\0';
+  return buffer;
+}
+
+MACAddressText MAC48::as(Representation representation) const {
+  uint8_t octets[6];
+  toOctets(octets);
+  return MACAddressText{octets, representation};
+}
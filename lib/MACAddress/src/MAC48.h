@@ -0,0 +1,284 @@
+#ifndef _MAC48_h_
+#define _MAC48_h_
+
+/*
+ *      @file: MAC48.h
+ */
+
+#include <Arduino.h>
+
+#include "MACAddressFormat.h"
+
+enum class MA {
+  L, // 24 bits for the userAddress
+  M, // 28  "    "   "      "
+  S  // 36  "    "   "      "
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MAC48 class is a lean value type holding the 48 bits of an address and
+ * nothing else: no text buffers, no vtable, no MA setting.
+ *
+ * It is trivially copyable, takes 8 bytes (a single register on 64 bits
+ * hosts) and is meant for large tables of addresses and for passing and
+ * returning addresses by value; it converts to and from MACAddress by copying
+ * the six octets (see MACAddress(const MAC48 &) and MACAddress::toMAC48()).
+ *
+ * The address is stored as an integer whose most significant byte (bits 40 to
+ * 47) is the first octet, so that value() == 0xABCDEF012345 for the address
+ * AB:CD:EF:01:23:45.
+ *
+ * The OUI and extension id accessors are therefore a single shift or mask
+ * and, as everything that does not touch memory, usable in constexpr code:
+ *
+ *   constexpr MAC48 mac{0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+ *   static_assert(mac.getOUI24() == 0xABCDEF, "");
+ *   static_assert(mac.withExtensionId24(0).value() == 0xABCDEF000000, "");
+ *
+ * Text is written into caller supplied buffers only.
+ *
+ * Constant addresses can be written as literals, parsed at compile time with
+ * the same grammar of MACAddress::fromString():
+ *
+ *   constexpr MAC48 gateway = "0:8:ab:cd:0:3"_mac;
+ *   const MAC48 known[] PROGMEM = {"0:8:ab:cd:0:3"_mac, "AB-CD-EF-01-23-45"_mac};
+ *   MACAddress mac{MAC48::read_P(&known[1])};
+ *
+ * They cost no startup parsing and no RAM (constexpr values are folded into
+ * the code, PROGMEM tables stay in flash). A malformed literal does not
+ * compile: with C++14 (or later) and GCC the literal is checked by a
+ * static_assert; on C++11 toolchains (avr-gcc) it is rejected as soon as it is
+ * evaluated in a constant expression (e.g. a constexpr variable or a PROGMEM
+ * table) by a call to mac_literal_is_malformed().
+ */
+// Deliberately not constexpr: see the "_mac" literal operator
+void mac_literal_is_malformed(void);
+
+class MAC48 {
+private:
+  static const uint32_t _max24{0xFFFFFFul};
+  static const uint32_t _max28{0xFFFFFFFul};
+  static const uint64_t _max36{0xFFFFFFFFFull};
+
+  uint64_t _value;
+
+  constexpr MAC48 _withBits(uint64_t mask, uint64_t n) const {
+    return MAC48{(_value & ~mask) | (n & mask)};
+  }
+
+  // Compile time version of MACAddressParser (C++11 constexpr: recursion)
+  static const uint64_t _invalid{~0ull};
+  static const uint8_t _no_nibble{0xFF};
+
+  static constexpr uint8_t _nibble(char c) {
+    return (c >= '0' && c <= '9')   ? static_cast<uint8_t>(c - '0')
+           : (c >= 'a' && c <= 'f') ? static_cast<uint8_t>(c - 'a' + 10)
+           : (c >= 'A' && c <= 'F') ? static_cast<uint8_t>(c - 'A' + 10)
+                                    : _no_nibble;
+  }
+
+  static constexpr uint64_t _scan(const char *p, const char *end, uint8_t n,
+                                  char separator, uint8_t x, bool first,
+                                  uint64_t value) {
+    return (p == end || *p == '\0')
+               ? (n == 5 ? (value << 8 | x) : _invalid)
+           : _nibble(*p) != _no_nibble
+               ? _scan(p + 1, end, n, separator,
+                       first ? _nibble(*p)
+                             : static_cast<uint8_t>((x << 4) + _nibble(*p)),
+                       !first, value)
+           : ((*p == ':' || *p == '-') &&
+              (separator == '\0' || *p == separator) && n != 5)
+               ? _scan(p + 1, end, n + 1, *p, 0, true, value << 8 | x)
+               : _invalid;
+  }
+
+  static constexpr uint64_t _scan(const char *address, size_t length) {
+    return _scan(address, address + length, 0, '\0', 0, true, 0);
+  }
+
+public:
+  // Masks of the 48 bits of an address, of its I/G bit (least significant bit
+  // of the first octet: group addresses) and of its U/L bit (the next one:
+  // locally administered addresses)
+  static constexpr uint64_t mask48{0xFFFFFFFFFFFFull};
+  static constexpr uint64_t ig_bit{0x010000000000ull};
+  static constexpr uint64_t ul_bit{0x020000000000ull};
+
+  // Size of the buffer needed by toString() (NUL terminator included)
+  static const uint8_t str_size{MACAddressFormat::size + 1};
+
+  constexpr MAC48(void) : _value{0} {}
+  constexpr explicit MAC48(uint64_t value) : _value{value & mask48} {}
+  constexpr MAC48(uint8_t first, uint8_t second, uint8_t third,
+                  uint8_t fourth, uint8_t fifth, uint8_t sixth)
+      : _value{static_cast<uint64_t>(first) << 40 |
+               static_cast<uint64_t>(second) << 32 |
+               static_cast<uint64_t>(third) << 24 |
+               static_cast<uint64_t>(fourth) << 16 |
+               static_cast<uint64_t>(fifth) << 8 | sixth} {}
+
+  // Compile time parsing (see the "_mac" literal operator)
+  static constexpr bool isValid(const char address[], size_t length) {
+    return _scan(address, length) != _invalid;
+  }
+  static constexpr MAC48 literal(const char address[], size_t length) {
+    return isValid(address, length)
+               ? MAC48{_scan(address, length)}
+               : (mac_literal_is_malformed(), MAC48{mask48});
+  }
+
+  // Reads a MAC48 stored in flash (PROGMEM)
+  static MAC48 read_P(const MAC48 *address) {
+    MAC48 rc;
+    memcpy_P(&rc, address, sizeof(rc));
+    return rc;
+  }
+
+  // Reads six octets (in transmission order)
+  static MAC48 fromOctets(const uint8_t octets[]) {
+    return MAC48{octets[0], octets[1], octets[2],
+                 octets[3], octets[4], octets[5]};
+  }
+
+  // Writes six octets (in transmission order)
+  void toOctets(uint8_t octets[]) const {
+    for (uint8_t i = 0; i != 6; ++i)
+      octets[i] = (*this)[i];
+  }
+
+  constexpr uint64_t value(void) const { return _value; }
+
+  // Octet i (0 is the first one in transmission order)
+  constexpr uint8_t operator[](uint8_t i) const {
+    return static_cast<uint8_t>(_value >> (40 - 8 * i));
+  }
+
+  // MA-L: 24 bits OUI, 24 bits extension id
+  constexpr uint32_t getOUI24(void) const {
+    return static_cast<uint32_t>(_value >> 24);
+  }
+  constexpr uint32_t getExtensionId24(void) const {
+    return static_cast<uint32_t>(_value & _max24);
+  }
+  constexpr MAC48 withExtensionId24(uint32_t n) const {
+    return _withBits(_max24, n);
+  }
+  void setExtensionId24(uint32_t n) { *this = withExtensionId24(n); }
+
+  // MA-M: 20 bits OUI, 28 bits extension id
+  constexpr uint32_t getOUI20(void) const {
+    return static_cast<uint32_t>(_value >> 28);
+  }
+  constexpr uint32_t getExtensionId28(void) const {
+    return static_cast<uint32_t>(_value & _max28);
+  }
+  constexpr MAC48 withExtensionId28(uint32_t n) const {
+    return _withBits(_max28, n);
+  }
+  void setExtensionId28(uint32_t n) { *this = withExtensionId28(n); }
+
+  // MA-S: 12 bits OUI, 36 bits extension id
+  constexpr uint32_t getOUI12(void) const {
+    return static_cast<uint32_t>(_value >> 36);
+  }
+  constexpr uint64_t getExtensionId36(void) const { return _value & _max36; }
+  constexpr MAC48 withExtensionId36(uint64_t n) const {
+    return _withBits(_max36, n);
+  }
+  void setExtensionId36(uint64_t n) { *this = withExtensionId36(n); }
+
+  // I/G bit (least significant bit of the first octet): group addresses
+  constexpr bool isMulticast(void) const { return (_value >> 40) & 0x01; }
+  constexpr bool isUnicast(void) const { return !isMulticast(); }
+  constexpr MAC48 withMulticast(bool multicast) const {
+    return _withBits(ig_bit, multicast ? ig_bit : 0);
+  }
+  void setMulticast(bool multicast) { *this = withMulticast(multicast); }
+  // U/L bit (second least significant bit of the first octet)
+  constexpr bool isLocal(void) const { return (_value >> 40) & 0x02; }
+  constexpr bool isUniversal(void) const { return !isLocal(); }
+  constexpr MAC48 withLocal(bool local) const {
+    return _withBits(ul_bit, local ? ul_bit : 0);
+  }
+  void setLocal(bool local) { *this = withLocal(local); }
+  constexpr bool isBroadcast(void) const { return _value == mask48; }
+
+  // The same accessors selected by the MA set
+  static constexpr uint64_t extensionIdMask(MA ma) {
+    return ma == MA::L ? _max24 : ma == MA::M ? _max28 : _max36;
+  }
+  constexpr uint64_t getExtensionId(MA ma) const {
+    return _value & extensionIdMask(ma);
+  }
+  constexpr MAC48 withExtensionId(MA ma, uint64_t n) const {
+    return _withBits(extensionIdMask(ma), n);
+  }
+  void setExtensionId(MA ma, uint64_t n) { *this = withExtensionId(ma, n); }
+
+  constexpr bool operator==(const MAC48 &mac) const {
+    return _value == mac._value;
+  }
+  constexpr bool operator!=(const MAC48 &mac) const {
+    return _value != mac._value;
+  }
+
+  // Addresses are ordered as their octets in transmission order (and as the
+  // 48 bits integers they are)
+  constexpr bool operator<(const MAC48 &mac) const {
+    return _value < mac._value;
+  }
+  constexpr bool operator<=(const MAC48 &mac) const {
+    return _value <= mac._value;
+  }
+  constexpr bool operator>(const MAC48 &mac) const {
+    return _value > mac._value;
+  }
+  constexpr bool operator>=(const MAC48 &mac) const {
+    return _value >= mac._value;
+  }
+
+  /*
+   * Writes the address into [first, last) without any terminator.
+   * @return: the end of the written characters, nullptr if the buffer is too
+   *          small (in which case nothing is written).
+   */
+  char *toChars(char *first, char *last,
+                Representation representation =
+                    Representation::COMMON_FULL) const;
+
+  // Writes the NUL terminated address into buffer (str_size characters)
+  char *toString(char buffer[],
+                 Representation representation =
+                     Representation::COMMON_FULL) const;
+
+  // Printable form of the address: Serial.print(mac.as(Representation::EUI48))
+  MACAddressText as(Representation representation =
+                        Representation::COMMON_FULL) const;
+};
+
+#if __cplusplus >= 201402L && defined(__GNUC__)
+// Text of a literal operator template (GNU extension for string literals)
+template <char... address> struct MAC48Literal {
+  static constexpr char text[] = {address..., '\0'};
+};
+
+template <char... address>
+constexpr char MAC48Literal<address...>::text[];
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+template <typename C, C... address> constexpr MAC48 operator"" _mac(void) {
+  static_assert(MAC48::isValid(MAC48Literal<address...>::text,
+                               sizeof...(address)),
+                "malformed MAC address literal");
+  return MAC48::literal(MAC48Literal<address...>::text, sizeof...(address));
+}
+#pragma GCC diagnostic pop
+#else
+constexpr MAC48 operator"" _mac(const char *address, size_t length) {
+  return MAC48::literal(address, length);
+}
+#endif
+
+#endif // _MAC48_h_
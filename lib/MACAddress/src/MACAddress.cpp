@@ -7,8 +7,7 @@
 
 #include "MACAddress.h"
 
-const char MACAddress::_hex[]{'0', '1', '2', '3', '4', '5', '6', '7',
-                              '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+#include "MACAddressStats.h"
 
 void MACAddress::_clearAddress(void) {
   for (auto i = 0; i != _length; ++i)
@@ -30,12 +29,6 @@ void MACAddress::_showOctetAssignmentFailure(void) {
 }
 #endif
 
-char MACAddress::_hexToNibble(char c) {
-  static const uint8_t delta = _hex[10] - 10;
-  c = toupper(c);
-  return c - (isdigit(c) ? _hex[0] : delta);
-}
-
 MACAddress::MACAddress(void)
     : _address{static_cast<uint8_t>(0xDE), static_cast<uint8_t>(0xAD),
                static_cast<uint8_t>(0xBE), static_cast<uint8_t>(0xEF),
@@ -81,23 +74,24 @@ MACAddress::MACAddress(char address[]) { fromString(address); }
 
 MACAddress::MACAddress(const char address[]) { fromString(address); }
 
-MACAddress::MACAddress(String address) { fromString(address); }
+MACAddress::MACAddress(const String &address) { fromString(address); }
 
 MACAddress::MACAddress(const __FlashStringHelper *address) {
   fromString(address);
 }
 
-MACAddress::MACAddress(MACAddress &mac) {
-  // self-assignment check
-  if (this != &mac)
-    memcpy(_address, mac._address, _address_size);
+MACAddress::MACAddress(const MACAddress &mac) : ma{mac.ma} {
+  memcpy(_address, mac._address, _address_size);
 }
 
-bool MACAddress::_fromString(char addr[]) {
+MACAddress::MACAddress(const MAC48 &mac) { mac.toOctets(_address); }
+
+bool MACAddress::_fromString(const char addr[]) {
   /*
    * Accepted MACs:
    *
    *   AB:CD:EF:01:23:45
+   *   AB-CD-EF-01-23-45
    *   A:A:A:A:A:B
    *   1:C0:FF:EE:4D:AD
    *   40::CO:FF:EE:51
@@ -107,148 +101,92 @@ bool MACAddress::_fromString(char addr[]) {
    *   8:0:12:34:56:78
    *   :::::1
    *   :::::
+   *
+   * The string is scanned in place, in a single pass and without any heap
+   * allocation (see MACAddressParser).
    */
-  bool rc = true;
-  uint8_t i = 0;
-  uint8_t colons = 0;
-
-  uint8_t len = strlen(addr);
-
-  char *tmp = new char[len + 1];
-  strncpy(tmp, addr, len);
-  tmp[len] = 0;
-
-  if (NULL != strchr(tmp, dash)) {
-    if (5 != _replace_all(tmp, dash, colon)) {
-      // Since this is not an EUI-48 MAC,
-      // we restore tmp to its original and initial value
-      // and - even though we know it is wrong - we just
-      // let the rest of this method discover it and
-      // act accordingly.
-      strncpy(tmp, addr, len);
-      tmp[len] = 0;
-    }
-  }
-
-  char *p = tmp; // Serial.printf(" BEG> addr: %p, p: %p\n", addr, p);
-
-  bool first = true;
-  uint8_t x = 0;
-
-  uint8_t n = 0, length = strlen(tmp);
-
-  while (*p) {
-    char c = *p++;
-    ++n;
-
-    if (isxdigit(c)) {
-      c = _hexToNibble(c);
-      x = first ? c : ((x << 4) + c);
-      first = !first;
-
-    } else if (c == colon) {
-      if (colons == 5) {
-        // Too many colons (there must be 3 colons)
-        rc = false;
-        break;
-      }
-
-      _address[i] = x;
-      ++i;
-      x = 0;
-      ++colons;
-      first = true;
-    } else {
-      // Invalid char
-      rc = false;
-      break;
-    }
-
-    if (n == length) {
-      // Last byte
-      _address[i] = x;
-      break;
-    }
-  }
-
-  // Too few colons (5 expected)
-  if (colons != 5)
-    rc = false;
+  bool rc = MACAddressParser::Status::OK ==
+            MACAddressParser::parse(addr, _address);
 
   if (!rc)
     _clearAddress();
 
-  delete[] tmp;
-
   return rc;
 }
 
 bool MACAddress::fromString(char address[]) { return _fromString(address); }
 
 bool MACAddress::fromString(const char address[]) {
-  char addr[_str_size];
-  strcpy(addr, (char *)(address));
-  return _fromString(addr);
+  return _fromString(address);
 }
 
 bool MACAddress::fromString(const __FlashStringHelper *address) {
-  char addr[_str_size];
-  strcpy_P(addr, (PGM_P)address);
-  return _fromString(addr);
-};
+  bool rc = MACAddressParser::Status::OK ==
+            MACAddressParser::parse_P(reinterpret_cast<PGM_P>(address),
+                                      _address);
 
-bool MACAddress::fromString(String address) {
-  // _fromString() is not directly callable
-  return fromString(address.c_str());
-};
+  if (!rc)
+    _clearAddress();
+
+  return rc;
+}
+
+bool MACAddress::fromString(const String &address) {
+  return _fromString(address.c_str());
+}
+
+/*
+    Parses the address at the beginning of buffer (which does not need to be
+    NUL terminated), reading at most length characters: colon, dash, Cisco
+    dotted and bare notations are recognized (see MACAddressParser).
+
+    @return: the number of characters consumed, 0 if there is no address, in
+             which case the address is cleared as fromString() does.
+
+    [code]
+    MACAddress mac;
+    Notation notation;
+    const char json[]{"\"mac\": \"0019.e8a2.0c41\", ..."};
+
+    size_t n = mac.parse(json + 8, sizeof(json) - 8, &notation);
+    // Here: 14 == n, Notation::DOTTED == notation
+    [/code]
+ */
+size_t MACAddress::parse(const char buffer[], size_t length,
+                         Notation *notation) {
+  size_t rc = MACAddressParser::parse(buffer, length, _address, notation);
+
+  if (0 == rc)
+    _clearAddress();
+
+  return rc;
+}
 
 char *MACAddress::c_str(Representation representation) {
-  char mask[] = "%02X:%02X:%02X:%02X:%02X:%02X"; // TODO: move to .code
-
-  switch (representation) {
-  case Representation::COMMON_FULL:
-    snprintf(_strCommonFull, _str_size, mask, _address[0], _address[1],
-             _address[2], _address[3], _address[4], _address[5]);
-    return _strCommonFull;
-    break;
-  case Representation::EUI48:
-    for (auto i = 4; i <= 24; i += 5)
-      mask[i] = dash;
-    snprintf(_strEUI48, _str_size, mask, _address[0], _address[1], _address[2],
-             _address[3], _address[4], _address[5]);
-    return _strEUI48;
-    break;
-  case Representation::COMMON_COMPACT:
-    break;
-  }
+  char *buffer = _strCommonCompact;
+  if (representation == Representation::COMMON_FULL)
+    buffer = _strCommonFull;
+  else if (representation == Representation::EUI48)
+    buffer = _strEUI48;
 
-  uint8_t j{0}, colons{0};
+  *toChars(buffer, buffer + _str_size - 1, representation) = '\0';
+  return buffer;
+}
 
-  nibbles addr[_length];
-  for (auto i = 0; i != _length; ++i)
-    addr[i].n = _address[i];
-
-  for (auto i = 0; i != _length; ++i) {
-    if (addr[i].left && addr[i].right) {
-      _strCommonCompact[j++] = _hex[addr[i].left];
-      _strCommonCompact[j++] = _hex[addr[i].right];
-    } else if (0 == addr[i].left) {
-      if (addr[i].right)
-        _strCommonCompact[j++] = _hex[addr[i].right];
-      // else ; // do nothing, we'll just add (if possible) the colon
-    } else if (!addr[i].right) {
-      _strCommonCompact[j++] = _hex[addr[i].left];
-      _strCommonCompact[j++] = _hex[0];
-    }
+char *MACAddress::toChars(char *first, char *last,
+                          Representation representation) const {
+  if (last - first >= MACAddressFormat::size)
+    return MACAddressFormat::write(first, _address, representation);
 
-    if (colons < 5) {
-      _strCommonCompact[j++] = colon;
-      ++colons;
-    }
-  }
-  _strCommonCompact[j] = '\0';
+  // a short buffer may still hold a compact address
+  char text[MACAddressFormat::size];
+  const size_t length = static_cast<size_t>(
+      MACAddressFormat::write(text, _address, representation) - text);
+  if (last - first < static_cast<ptrdiff_t>(length))
+    return nullptr;
 
-  return _strCommonCompact;
+  memcpy(first, text, length);
+  return first + length;
 }
 
 uint8_t MACAddress::operator[](int i) const { return _address[i]; }
@@ -262,9 +200,11 @@ MACAddress &MACAddress::operator=(const uint8_t *address) {
 
 MACAddress &MACAddress::operator=(const MACAddress &mac) {
   // self-assignment check
-  if (this != &mac)
+  if (this != &mac) {
     for (auto i = 0; i != _length; ++i)
       _address[i] = mac[i];
+    ma = mac.ma;
+  }
 
   return *this;
 }
@@ -273,30 +213,66 @@ bool MACAddress::operator==(const MACAddress &mac) const {
   return 0 == memcmp(_address, mac._address, _address_size);
 }
 
+/*
+ * Sink comparing the scanned octets with the ones of an address; stops the
+ * scan at the first mismatch unless the whole string must be read anyway.
+ */
+struct MACAddressMatcher {
+  const uint8_t *octets;
+  bool stop;
+  bool match;
+
+  bool operator()(uint8_t i, uint8_t octet) {
+    match = match && octets[i] == octet;
+    return match || !stop;
+  }
+};
+
+/*
+ * Compares the address with the string read from source, as a temporary
+ * MACAddress built from it would: an invalid string stands for
+ * FF:FF:FF:FF:FF:FF (see _clearAddress()), so only that address needs to
+ * validate the whole string, the others stop at the first differing octet.
+ */
+template <typename Source>
+static bool _matches(const uint8_t address[], Source source) {
+  static const uint8_t ones[]{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  const bool cleared = 0 == memcmp(address, ones, sizeof(ones));
+
+  MACADDRESS_STATS_SCOPE(COMPARE);
+  MACAddressMatcher matcher{address, !cleared, true};
+  MACAddressParser::Status rc = MACAddressParser::scanAll(source, matcher);
+  MACADDRESS_STATS_FAILURE(rc);
+  return rc == MACAddressParser::Status::OK ? matcher.match : cleared;
+}
+
 bool MACAddress::operator==(char *address) const {
-  MACAddress mac{address};
-  return operator==(mac);
+  return _matches(_address, MACAddressParser::RamSource{address});
 }
 
 bool MACAddress::operator==(const char *address) const {
-  MACAddress mac{address};
-  return operator==(mac);
+  return _matches(_address, MACAddressParser::RamSource{address});
 }
 
 bool MACAddress::operator==(const __FlashStringHelper *address) const {
-  MACAddress mac{address};
-  return operator==(mac);
+  return _matches(_address, MACAddressParser::FlashSource{
+                                reinterpret_cast<PGM_P>(address)});
 }
 
-bool MACAddress::operator==(String address) const {
-  MACAddress mac{address};
-  return operator==(mac);
+bool MACAddress::operator==(const String &address) const {
+  return _matches(_address, MACAddressParser::RamSource{address.c_str()});
 }
 
 bool MACAddress::operator==(const uint8_t *address) const {
   return 0 == memcmp(_address, address, _address_size);
 }
 
+// Same as the comparison with the bytes the view reads; the overload keeps
+// mac == view unambiguous where C++20 also considers view == mac
+bool MACAddress::operator==(const MACAddressView &view) const {
+  return operator==(view.data());
+}
+
 bool MACAddress::operator!=(const MACAddress &mac) const {
   return !(*this == mac);
 }
@@ -311,7 +287,7 @@ bool MACAddress::operator!=(const __FlashStringHelper *address) const {
   return !(*this == address);
 }
 
-bool MACAddress::operator!=(String address) const {
+bool MACAddress::operator!=(const String &address) const {
   return !(*this == address);
 }
 
@@ -319,264 +295,112 @@ bool MACAddress::operator!=(const uint8_t *address) const {
   return !(*this == address);
 }
 
-MACAddress &MACAddress::_sum(int64_t n, bool add) {
-  int64_t x{static_cast<int64_t>(0)};
-  int64_t divisor{_max24 + 1}; // default divisor
-
-  /*
-     Pointers to functions to just have the initial switch and not the 2nd
-     require extra code since the methods signatures are different:
-
-       - uint32_t getExtensionId24() == (uint32_t *)func(void)
-       - uint32_t getExtensionId28() == (uint32_t *)func(void)
-       - uint64_t getExtensionId36() == (uint64_t *)func(void)
-
-       - void setExtensionId24(uint32_t) == (void *)func(uint32_t)
-       - void setExtensionId28(uint32_t) == (void *)func(uint32_t)
-       - void setExtensionId36(uint64_t) == (void *)func(uint64_t)
-
-     For this reason and because I don't want to be too smart, the 2nd switch
-     is going to stay.
-   */
-  switch (ma) {
-  case MA::L:
-    // divisor = _max24 + 1; // default divisor
-    x = getExtensionId24();
-    break;
-
-  case MA::M:
-    divisor = _max28 + 1;
-    x = getExtensionId28();
-    break;
-
-  case MA::S:
-    divisor = _max36 + 1;
-    x = getExtensionId36();
-    break;
-  }
-
-  n %= divisor; // assure the range by using circular arithmetic
-  add ? x += n : x -= n;
-
-  // TODO: check the circular arithmetic when x < 0;
-
-  x %= divisor; // assure the range by using circular arithmetic
-
-  switch (ma) {
-  case MA::L:
-    setExtensionId24(x);
-    break;
-
-  case MA::M:
-    setExtensionId28(x);
-    break;
-
-  case MA::S:
-    setExtensionId36(x);
-    break;
-  }
-
-  return *this;
+bool MACAddress::operator!=(const MACAddressView &view) const {
+  return !(*this == view);
 }
 
-MACAddress &MACAddress::operator+=(int64_t n) {
-  return (n < 0) ? operator-=(-n) : _sum(n, true);
+bool MACAddress::operator<(const MACAddress &mac) const {
+  return memcmp(_address, mac._address, _address_size) < 0;
 }
 
-MACAddress &MACAddress::operator-=(int64_t n) {
-  return (n < 0) ? operator+=(-n) : _sum(n, false);
+bool MACAddress::operator<=(const MACAddress &mac) const {
+  return !(mac < *this);
 }
 
-MACAddress &MACAddress::operator+(int64_t n) { return MACAddress(*this) += n; }
-
-MACAddress &MACAddress::operator-(int64_t n) { return MACAddress(*this) -= n; }
-
-MACAddress &MACAddress::operator++(void) { return operator+=(1); }
-
-MACAddress &MACAddress::operator--(void) { return operator-=(1); }
-
-MACAddress::operator uint8_t *(void) { return _address; }
-
-MACAddress::operator char *(void) { return c_str(); }
-
-uint32_t MACAddress::getOUI24(void) {
-  id32 rc;
+bool MACAddress::operator>(const MACAddress &mac) const { return mac < *this; }
 
-  for (auto i = 0; i != 3; ++i)
-    rc.octet[i] = _address[2 - i];
-
-  return rc.n;
-}
-
-uint32_t MACAddress::getOUI20(void) {
-  id32 rc;
-
-  for (auto i = 0; i != 3; ++i)
-    rc.octet[i] = _address[2 - i];
-
-  rc.n >>= 4;
-
-  return rc.n;
+bool MACAddress::operator>=(const MACAddress &mac) const {
+  return !(*this < mac);
 }
 
-uint32_t MACAddress::getOUI12(void) {
-  id32 rc;
-
-  for (auto i = 0; i != 2; ++i)
-    rc.octet[i] = _address[1 - i];
+MACAddress &MACAddress::_sum(int64_t n, bool add) {
+  MACADDRESS_STATS_SCOPE(ARITHMETIC);
 
-  rc.n >>= 4;
+  /*
+   * The extension id is the field of the 24, 28 or 36 least significant bits
+   * of the 48 bits integer (see MAC48): unsigned arithmetic masked to the
+   * field is circular, modulo 2^24, 2^28 or 2^36, with no division and no
+   * negative intermediate values.
+   */
+  const MAC48 mac = toMAC48();
+  const uint64_t mask = MAC48::extensionIdMask(ma);
+  const uint64_t x = mac.getExtensionId(ma);
+  // |n| and the direction it moves to (-INT64_MIN included)
+  const uint64_t distance =
+      n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n);
+  const bool up = add == (n >= 0);
+  const uint64_t step = distance & mask;
+
+#if MACADDRESS_STATS
+  if (distance > mask || (up ? x + step > mask : step > x))
+    MACADDRESS_STATS_WRAP();
+#endif
 
-  return rc.n;
+  mac.withExtensionId(ma, up ? x + step : x - step).toOctets(_address);
+  return *this;
 }
 
-uint32_t MACAddress::getExtensionId24(void) {
-  id32 rc;
+MACAddress &MACAddress::operator+=(int64_t n) { return _sum(n, true); }
 
-  for (auto i = 0; i != 3; ++i)
-    rc.octet[i] = _address[_length - 1 - i];
+MACAddress &MACAddress::operator-=(int64_t n) { return _sum(n, false); }
 
-  return rc.n;
+MACAddress MACAddress::operator+(int64_t n) const {
+  MACAddress rc{*this};
+  rc += n;
+  return rc;
 }
 
-uint32_t MACAddress::getExtensionId28(void) {
-  id32 rc;
-
-  for (auto i = 0; i != 4; ++i)
-    rc.octet[i] = _address[_length - 1 - i];
-
-  // reread the last octet and adjust it
-  rc.octet[3] = getRightNibble(rc.octet[3]);
-
-  return rc.n;
+MACAddress MACAddress::operator-(int64_t n) const {
+  MACAddress rc{*this};
+  rc -= n;
+  return rc;
 }
 
-uint64_t MACAddress::getExtensionId36(void) {
-  id36 rc;
+MACAddress &MACAddress::operator++(void) { return operator+=(1); }
 
-  for (auto i = 0; i != 5; ++i)
-    rc.octet[i] = _address[_length - 1 - i];
+MACAddress &MACAddress::operator--(void) { return operator-=(1); }
 
-  // reread the last octet and adjust it
-  rc.octet[4] = getRightNibble(rc.octet[4]);
+MACAddress::operator uint8_t *(void) { return _address; }
 
-  return rc.n;
-}
+MACAddress::operator char *(void) { return c_str(); }
 
 void MACAddress::setExtensionId24(uint32_t n) {
-  id32 x;
-
-  x.n = n;
-
-  _address[3] = x.octet[2];
-  _address[4] = x.octet[1];
-  _address[5] = x.octet[0];
+  toMAC48().withExtensionId24(n).toOctets(_address);
 }
 
 void MACAddress::setExtensionId28(uint32_t n) {
-  id32 x;
-  x.n = n;
-
-  _address[2] = getLeftNibble(_address[2]) + getRightNibble(x.octet[3]);
-  _address[3] = x.octet[2];
-  _address[4] = x.octet[1];
-  _address[5] = x.octet[0];
+  toMAC48().withExtensionId28(n).toOctets(_address);
 }
 
 void MACAddress::setExtensionId36(uint64_t n) {
-  id36 x;
-  x.n = n;
-
-  _address[1] = getLeftNibble(_address[1]) + getRightNibble(x.octet[4]);
-  _address[2] = x.octet[3];
-  _address[3] = x.octet[2];
-  _address[4] = x.octet[1];
-  _address[5] = x.octet[0];
+  toMAC48().withExtensionId36(n).toOctets(_address);
 }
 
-uint8_t MACAddress::_replace_all(char *target, char what, char with) {
-  uint8_t rc = 0;
-
-  for (auto i = 0; i != static_cast<uint8_t>(strlen(target)); ++i)
-    if (what == target[i]) {
-      target[i] = with;
-      ++rc;
-    }
+void MACAddress::setMulticast(bool multicast) {
+  _address[0] = static_cast<uint8_t>(multicast ? _address[0] | 0x01
+                                               : _address[0] & ~0x01);
+}
 
-  return rc;
+void MACAddress::setLocal(bool local) {
+  _address[0] = static_cast<uint8_t>(local ? _address[0] | 0x02
+                                           : _address[0] & ~0x02);
 }
 
 char *MACAddress::uint64ToHex(uint64_t n) {
-  // method by ataraxic
-  // @see
-  // http://stackoverflow.com/questions/9225567/how-to-print-a-int64-t-type-in-c
-  static char buffer[32]{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  char *p = &buffer[31];
-  auto base = 16;
-
-  do {
-    *p = _hex[n % base];
-    --p;
-    n /= base;
-  } while (n);
+  static char buffer[16 + 1];
 
-  return p + 1;
+  *MACAddressFormat::hexToChars(buffer, buffer + sizeof(buffer) - 1, n) = '\0';
+  return buffer;
 }
 
-/*
-    @parameter what: [0, 255].
-    @parameter readyToBeJoined: true(default)|false.
-
-    [code]
-    bool rc;
-    uint8_t what { 0xFA };
-
-    if(readyToBeJoined) {
-      rc = (0xF0 == getLeftNibble(what)) == (0xF0 == getLeftNibble(what,
-                                                                   true));
-    } else {
-      rc = 0x0F == getLeftNibble(what, false);
-    }
-    // Here: true == rc
-    [/code]
- */
-uint8_t MACAddress::getLeftNibble(uint8_t what, bool readyToBeJoined) {
-  uint8_t rc{static_cast<uint8_t>(what >> 4)};
-  if (readyToBeJoined)
-    rc <<= 4;
-  return rc;
+size_t MACAddress::printTo(Print &p) const {
+  return printTo(p, Representation::COMMON_FULL);
 }
 
-/*
-    @parameter what: [0, 255].
-
-    [code]
-    uint8_t what { 0xFA };
-
-    // Below: true == rc1
-    bool rc1 = 0x0A == getRightNibble(what, false);
-
-    // below: true == rc2
-    bool rc2 = 0xFA == (getLeftNibble(what) + getRightNibble(what));
-    [/code]
- */
-uint8_t MACAddress::getRightNibble(uint8_t what) {
-  uint8_t rc{static_cast<uint8_t>(what << 4)};
-  return rc >>= 4;
+size_t MACAddress::printTo(Print &p, Representation representation) const {
+  return MACAddressFormat::print(p, _address, representation);
 }
 
-size_t MACAddress::printTo(Print &p) const {
-  size_t n{static_cast<size_t>(0)};
-
-  for (auto i = 0; i < _length; i++) {
-    auto value = _address[i];
-    if (value < 0x10)
-      n += p.print(_hex[0]);
-    n += p.print(value, HEX);
-    if (i != 5)
-      n += p.print(colon);
-  }
-
-  return n;
+MACAddressText MACAddress::as(Representation representation) const {
+  return MACAddressText{_address, representation};
 }
@@ -10,13 +10,10 @@
 
 #include <Arduino.h>
 
-enum class Representation { EUI48, COMMON_FULL, COMMON_COMPACT };
-
-enum class MA {
-  L, // 24 bits for the userAddress
-  M, // 28  "    "   "      "
-  S  // 36  "    "   "      "
-};
+#include "MAC48.h"
+#include "MACAddressFormat.h"
+#include "MACAddressParser.h"
+#include "MACAddressView.h"
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * The MACAddress class is and should be useful to work with many administered
@@ -42,46 +39,23 @@ enum class MA {
  * To quickly access the address as an array of characters or unsigned integers,
  * casting methods are provided.
  *
+ * Large tables of addresses should rather use the MAC48 value type (8 bytes
+ * instead of the 60+ of a MACAddress object), converting when needed.
+ *
  * The ancestor
  *  - Printable
  * and the public method
  * - virtual size_t printTo(Print& p) const;
- * allow MACAddress objects to be printed to streams.
+ * allow MACAddress objects to be printed to streams, with a single write per
+ * address; as() selects another representation and MACAddressPrinter buffers
+ * many addresses into fewer writes.
  */
 class MACAddress : public Printable {
 private:
-  typedef union {
-    uint32_t n{static_cast<uint32_t>(0)};
-    uint8_t octet[4];
-  } id32;
-  typedef union {
-    uint64_t n{static_cast<uint64_t>(0)};
-    struct {
-      uint8_t octet[5];
-      uint8_t extra[3];
-    };
-  } id36;
-  typedef union {
-    uint8_t n{static_cast<uint8_t>(0)}; // initialization added for consistency
-    struct {
-      uint8_t right : 4;
-      uint8_t left : 4;
-    };
-  } nibbles;
-
-  uint8_t getLeftNibble(uint8_t what, bool readyToBeJoined = true);
-  uint8_t getRightNibble(uint8_t what);
-
   // Constants shared by all MACAddress objects
-  static const char colon = ':';
-  static const char dash = '-';
   static const uint8_t _length{6};
   static const uint8_t _address_size{sizeof(uint8_t) * _length};
   static const uint8_t _str_size{17 + 1};
-  static const char _hex[];
-  static const uint32_t _max24{0xFFFFFFul};    // [0, 2^24 - 1] == [0, 2^24)
-  static const uint32_t _max28{0xFFFFFFFul};   // [0, 2^28 - 1] == [0, 2^28)
-  static const uint64_t _max36{0xFFFFFFFFFul}; // [0, 2^36 - 1] == [0, 2^36)
 
   uint8_t _address[_length];
   char _strCommonFull[_str_size];
@@ -89,8 +63,7 @@ private:
   char _strEUI48[_str_size];
 
 protected:
-  bool _fromString(char addr[]);
-  char _hexToNibble(char c);
+  bool _fromString(const char addr[]);
   void _clearAddress(void);
   bool _validOctet(int n) { return n >= 0 && n < 256; };
   bool _validOctets(int first, int second, int third, int fourth, int fifth,
@@ -98,43 +71,79 @@ protected:
 #ifdef DEBUG
   void _showOctetAssignmentFailure(void);
 #endif
-  uint8_t _replace_all(char *target, char what, char with);
   MACAddress &_sum(int64_t n, bool add);
 
 public:
   MA ma{MA::L};
+  // Hexadecimal form of n in a buffer shared by every call (see
+  // MACAddressFormat::hexToChars to write it into a buffer of your own)
   char *uint64ToHex(uint64_t n);
-  uint32_t getOUI24(void);
-  uint32_t getExtensionId24(void);
+  // The OUI and extension id accessors work on the packed 48 bits integer of
+  // the address (see MAC48): a single shift or mask, independent of the host
+  // endianness
+  uint32_t getOUI24(void) const { return toMAC48().getOUI24(); }
+  uint32_t getExtensionId24(void) const { return toMAC48().getExtensionId24(); }
   void setExtensionId24(uint32_t n);
 
-  uint32_t getOUI20(void);
-  uint32_t getExtensionId28(void);
+  uint32_t getOUI20(void) const { return toMAC48().getOUI20(); }
+  uint32_t getExtensionId28(void) const { return toMAC48().getExtensionId28(); }
   void setExtensionId28(uint32_t n);
 
-  uint32_t getOUI12(void);
-  uint64_t getExtensionId36(void);
+  uint32_t getOUI12(void) const { return toMAC48().getOUI12(); }
+  uint64_t getExtensionId36(void) const { return toMAC48().getExtensionId36(); }
   void setExtensionId36(uint64_t n);
 
+  // I/G bit (least significant bit of the first octet): group addresses
+  bool isMulticast(void) const { return _address[0] & 0x01; }
+  bool isUnicast(void) const { return !isMulticast(); }
+  void setMulticast(bool multicast);
+  // U/L bit (second least significant bit of the first octet): locally
+  // administered addresses
+  bool isLocal(void) const { return _address[0] & 0x02; }
+  bool isUniversal(void) const { return !isLocal(); }
+  void setLocal(bool local);
+
   MACAddress(void);
   MACAddress(uint8_t address[]);
   MACAddress(int address[]);
   MACAddress(char address[]);
   MACAddress(const char address[]);
   MACAddress(const __FlashStringHelper *address);
-  MACAddress(String address);
+  MACAddress(const String &address);
   MACAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth,
              uint8_t fifth, uint8_t sixth);
   MACAddress(int first, int second, int third, int fourth, int fifth,
              int sixth);
-  MACAddress(MACAddress &mac);
+  MACAddress(const MACAddress &mac);
+  MACAddress(const MAC48 &mac);
 
   bool fromString(const char address[]);
   bool fromString(char address[]);
   bool fromString(const __FlashStringHelper *address);
-  bool fromString(String address);
+  bool fromString(const String &address);
+  size_t parse(const char buffer[], size_t length,
+               Notation *notation = nullptr);
+  // Writes the NUL terminated address into a buffer of the object, rewritten
+  // by every call in the same representation (see toChars)
   char *c_str(Representation representation = Representation::COMMON_FULL);
 
+  /*
+   * Writes the address into [first, last) without any terminator: reentrant,
+   * it only touches the caller's buffer (MACAddressFormat::size characters at
+   * most).
+   * @return: the end of the written characters, nullptr if the buffer is too
+   *          small (in which case nothing is written).
+   */
+  char *toChars(char *first, char *last,
+                Representation representation =
+                    Representation::COMMON_FULL) const;
+
+  // Lean copy of the address (see MAC48)
+  MAC48 toMAC48(void) const {
+    return MAC48{_address[0], _address[1], _address[2],
+                 _address[3], _address[4], _address[5]};
+  }
+
   // Copy operator to allow initialization of MACAddress objects from different
   // types
   MACAddress &operator=(const uint8_t *address);
@@ -146,13 +155,15 @@ public:
   uint8_t &operator[](int i);
 
   // Overloaded comparison operator to allow checking for equality between
-  // different MACAddress objects / arrays
+  // different MACAddress objects / arrays; strings are compared as they are
+  // read, without building a temporary address
   bool operator==(const MACAddress &mac) const;
   bool operator==(char *address) const;
   bool operator==(const char *address) const;
   bool operator==(const __FlashStringHelper *address) const;
-  bool operator==(String address) const;
+  bool operator==(const String &address) const;
   bool operator==(const uint8_t *address) const;
+  bool operator==(const MACAddressView &view) const;
 
   // Overloaded inequality operator to allow checking for inequality between
   // different MACAddress objects / arrays
@@ -160,14 +171,22 @@ public:
   bool operator!=(char *address) const;
   bool operator!=(const char *address) const;
   bool operator!=(const __FlashStringHelper *address) const;
-  bool operator!=(String address) const;
+  bool operator!=(const String &address) const;
   bool operator!=(const uint8_t *address) const;
+  bool operator!=(const MACAddressView &view) const;
+
+  // Overloaded relational operators ordering the addresses as their octets
+  // (e.g. for sorting)
+  bool operator<(const MACAddress &mac) const;
+  bool operator<=(const MACAddress &mac) const;
+  bool operator>(const MACAddress &mac) const;
+  bool operator>=(const MACAddress &mac) const;
 
   MACAddress &operator+=(int64_t n);
   MACAddress &operator-=(int64_t n);
 
-  MACAddress &operator+(int64_t n);
-  MACAddress &operator-(int64_t n);
+  MACAddress operator+(int64_t n) const;
+  MACAddress operator-(int64_t n) const;
 
   // pre-increment operator overloading (no post-increment)
   MACAddress &operator++(void);
@@ -182,7 +201,13 @@ public:
   // where a pointer to a string is expected
   operator char *(void);
 
+  // Prints the address with a single write (COMMON_FULL by default)
   virtual size_t printTo(Print &p) const;
+  size_t printTo(Print &p, Representation representation) const;
+
+  // Printable form of the address in the given representation:
+  //   Serial.println(mac.as(Representation::EUI48));
+  MACAddressText as(Representation representation) const;
 };
 
 #endif // _MACAddress_h_
@@ -0,0 +1,70 @@
+/*
+ *      @file: MACAddressAllocator.cpp
+ */
+
+#include "MACAddressAllocator.h"
+
+#ifdef MACADDRESS_HAS_ATOMIC
+
+MACAddressAllocator::MACAddressAllocator(MAC48 base, MA ma, uint64_t first,
+                                         uint64_t last)
+    : _base{base}, _ma{ma},
+      _last{last > MAC48::extensionIdMask(ma) ? MAC48::extensionIdMask(ma) + 1
+                                              : last},
+      _next{first < _last ? first : _last} {}
+
+MACAddressAllocator::MACAddressAllocator(const MACAddress &mac)
+    : MACAddressAllocator{mac.toMAC48(), mac.ma,
+                          mac.toMAC48().getExtensionId(mac.ma)} {}
+
+uint64_t MACAddressAllocator::_claim(uint64_t &n) {
+  // the claim is capped at the end of the range, so that _next never passes
+  // _last (a plain fetch_add of a large n would wrap it around)
+  uint64_t next = _next.load(std::memory_order_relaxed);
+  do {
+    if (next >= _last || 0 == n) {
+      n = 0;
+      return _last;
+    }
+    if (n > _last - next)
+      n = _last - next;
+  } while (!_next.compare_exchange_weak(next, next + n,
+                                        std::memory_order_relaxed));
+  return next;
+}
+
+bool MACAddressAllocator::allocate(MAC48 &mac) {
+  uint64_t n{1};
+  const uint64_t next = _claim(n);
+  if (0 == n)
+    return false;
+
+  mac = _base.withExtensionId(_ma, next);
+  return true;
+}
+
+uint64_t MACAddressAllocator::allocate(uint64_t n, MAC48 &first) {
+  const uint64_t next = _claim(n);
+  if (0 != n)
+    first = _base.withExtensionId(_ma, next);
+  return n;
+}
+
+bool MACAddressAllocator::reserve(uint64_t n, Lease &lease) {
+  MAC48 first;
+  const uint64_t claimed = allocate(n, first);
+
+  lease._base = _base;
+  lease._ma = _ma;
+  lease._next = first.getExtensionId(_ma);
+  lease._end = lease._next + claimed;
+
+  return 0 != claimed;
+}
+
+uint64_t MACAddressAllocator::remaining(void) const {
+  const uint64_t next = _next.load(std::memory_order_relaxed);
+  return next < _last ? _last - next : 0;
+}
+
+#endif // MACADDRESS_HAS_ATOMIC
@@ -0,0 +1,109 @@
+#ifndef _MACAddressAllocator_h_
+#define _MACAddressAllocator_h_
+
+/*
+ *      @file: MACAddressAllocator.h
+ *
+ * Only available where the toolchain provides <atomic> (hosts, ESP boards):
+ * not on AVR boards.
+ */
+
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#define MACADDRESS_HAS_ATOMIC 1
+#endif
+#endif
+
+#ifdef MACADDRESS_HAS_ATOMIC
+
+#include <atomic>
+
+#include "MACAddress.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressAllocator class hands out the addresses of a block (an OUI in
+ * one of the MA-L, MA-M or MA-S sets plus a range of extension ids) to any
+ * number of threads, without locks: a claim is a single atomic
+ * compare-and-swap (retried only when another thread claimed in between).
+ *
+ * Unlike the MACAddress arithmetic (which wraps around within the block), the
+ * allocator never reissues an address: once the range is exhausted every
+ * claim fails.
+ *
+ * Single addresses and batches of consecutive addresses can be claimed;
+ * workers handing out many addresses should rather reserve a Lease (a private
+ * sub-range consumed without any atomic operation) to avoid contention on
+ * the shared counter.
+ */
+class MACAddressAllocator {
+public:
+  // A sub-range of extension ids owned by a single thread
+  class Lease {
+  private:
+    MAC48 _base;
+    MA _ma{MA::L};
+    uint64_t _next{0};
+    uint64_t _end{0};
+
+    friend class MACAddressAllocator;
+
+  public:
+    // Hands out the next address, returns false if the lease is exhausted
+    bool next(MAC48 &mac) {
+      if (_next == _end)
+        return false;
+      mac = _base.withExtensionId(_ma, _next++);
+      return true;
+    }
+
+    uint64_t remaining(void) const { return _end - _next; }
+  };
+
+  /*
+   * Allocator of the extension ids [first, last) of the block of base in the
+   * ma set; by default the whole block.
+   */
+  MACAddressAllocator(MAC48 base, MA ma, uint64_t first = 0,
+                      uint64_t last = _whole);
+
+  // Allocator of the rest of the block of mac (in its ma set), mac included
+  explicit MACAddressAllocator(const MACAddress &mac);
+
+  MACAddressAllocator(const MACAddressAllocator &) = delete;
+  MACAddressAllocator &operator=(const MACAddressAllocator &) = delete;
+
+  // Claims one address, returns false if the range is exhausted
+  bool allocate(MAC48 &mac);
+
+  /*
+   * Claims up to n consecutive addresses (less only at the end of the range),
+   * first receiving the first one.
+   * @return: the number of addresses claimed, 0 if the range is exhausted.
+   */
+  uint64_t allocate(uint64_t n, MAC48 &first);
+
+  // Claims up to n consecutive addresses as a Lease, false if exhausted
+  bool reserve(uint64_t n, Lease &lease);
+
+  uint64_t remaining(void) const;
+  bool exhausted(void) const { return 0 == remaining(); }
+
+  MA ma(void) const { return _ma; }
+
+private:
+  static const uint64_t _whole{~0ull};
+
+  const MAC48 _base;
+  const MA _ma;
+  const uint64_t _last;
+
+  // Next extension id to hand out, never beyond _last
+  std::atomic<uint64_t> _next;
+
+  // Claims up to n ids from the returned one, n becoming the number claimed
+  uint64_t _claim(uint64_t &n);
+};
+
+#endif // MACADDRESS_HAS_ATOMIC
+
+#endif // _MACAddressAllocator_h_
@@ -0,0 +1,385 @@
+/*
+ *      @file: MACAddressArchive.cpp
+ */
+
+#include "MACAddressArchive.h"
+
+#ifdef MACADDRESS_HAS_STDIO
+
+#include <string.h>
+#include <sys/types.h>
+
+#include "MACAddressBatch.h"
+#include "MACAddressSort.h"
+
+/*
+ * Layout of the file (host byte order, checked through _endian):
+ *
+ *   header | chunk header, encoded addresses | ... | index | trailer
+ *
+ * The index holds an Entry per chunk; the trailer, at the end of the file,
+ * locates it.
+ */
+static const char _magic[8]{'M', 'A', 'C', 'P', 'A', 'C', 'K', '\1'};
+static const uint32_t _endian{0x01020304};
+static const uint64_t _id_mask{0xFFFFFF};
+
+struct MACAddressArchiveHeader {
+  char magic[8];
+  uint32_t endian;
+  uint32_t chunk;
+};
+
+struct MACAddressArchiveChunk {
+  uint32_t count;
+  uint32_t bytes;
+};
+
+struct MACAddressArchiveTrailer {
+  uint64_t index;
+  uint64_t addresses;
+  uint32_t chunks;
+  uint32_t ordered;
+  char magic[8];
+};
+
+// Longest encoding of count addresses: a group per address, each one made
+// of a 24 bits OUI difference, a 32 bits count and a 24 bits extension id
+static size_t _encodedMax(size_t count) { return (4 + 5 + 4) * count; }
+
+static uint8_t *_putVarint(uint8_t *out, uint64_t n) {
+  while (n >= 0x80) {
+    *out++ = static_cast<uint8_t>(n | 0x80);
+    n >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(n);
+  return out;
+}
+
+// Next varint of [p, end), at most 32 bits: false if truncated or too long
+static bool _getVarint(const uint8_t *&p, const uint8_t *end, uint64_t &n) {
+  n = 0;
+  for (uint8_t shift = 0; p != end && shift < 35; shift += 7) {
+    const uint8_t byte = *p++;
+    n |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+/*
+ * Encodes count sorted values into out (_encodedMax(count) bytes at most):
+ * groups of addresses sharing an OUI.
+ * @return: the end of the encoded bytes.
+ */
+static uint8_t *_encodeChunk(const MAC48 values[], size_t count,
+                             uint8_t *out) {
+  uint64_t oui{0};
+  for (size_t i = 0; i != count;) {
+    const uint64_t group_oui = values[i].value() >> 24;
+    size_t n{1};
+    while (i + n != count && values[i + n].value() >> 24 == group_oui)
+      ++n;
+
+    out = _putVarint(out, group_oui - oui);
+    out = _putVarint(out, n);
+    uint64_t id{0};
+    for (size_t j = i; j != i + n; ++j) {
+      out = _putVarint(out, (values[j].value() & _id_mask) - id);
+      id = values[j].value() & _id_mask;
+    }
+
+    oui = group_oui;
+    i += n;
+  }
+  return out;
+}
+
+// Decodes count values from [p, end), which they must fill exactly
+static bool _decodeChunk(const uint8_t *p, const uint8_t *end, size_t count,
+                         MAC48 values[]) {
+  uint64_t oui{0};
+  for (size_t i = 0; i != count;) {
+    uint64_t delta, n;
+    if (!_getVarint(p, end, delta) || !_getVarint(p, end, n) || n == 0 ||
+        n > count - i)
+      return false;
+    oui += delta;
+    if (oui > _id_mask)
+      return false;
+
+    uint64_t id{0};
+    for (const size_t last = i + n; i != last; ++i) {
+      if (!_getVarint(p, end, delta))
+        return false;
+      id += delta;
+      if (id > _id_mask)
+        return false;
+      values[i] = MAC48{oui << 24 | id};
+    }
+  }
+  return p == end;
+}
+
+MACAddressArchive::Writer::Writer(uint32_t chunk)
+    : _chunk{chunk != 0 ? chunk : chunk_size} {}
+
+bool MACAddressArchive::Writer::open(const char *path) {
+  close();
+  FILE *file = fopen(path, "wb");
+  if (file == nullptr)
+    return false;
+  if (!open(file)) {
+    fclose(file);
+    return false;
+  }
+  _owned = true;
+  return true;
+}
+
+bool MACAddressArchive::Writer::open(FILE *file) {
+  close();
+  _file = file;
+  _ok = true;
+  _ordered = true;
+  _offset = 0;
+  _addresses = 0;
+  _last = 0;
+  _index.clear();
+  _values.clear();
+  _values.reserve(_chunk);
+  _scratch.resize(_chunk);
+  _bytes.resize(_encodedMax(_chunk));
+
+  MACAddressArchiveHeader header;
+  memcpy(header.magic, _magic, sizeof(_magic));
+  header.endian = _endian;
+  header.chunk = _chunk;
+  if (!_write(&header, sizeof(header))) {
+    _file = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool MACAddressArchive::Writer::_write(const void *data, size_t size) {
+  // nothing to write (e.g. the index of an empty archive, whose data() may
+  // be nullptr, which fwrite() must not get)
+  if (size == 0)
+    return _ok;
+  if (_ok && fwrite(data, 1, size, _file) != size)
+    _ok = false;
+  _offset += size;
+  return _ok;
+}
+
+bool MACAddressArchive::Writer::_flush(void) {
+  if (_values.empty())
+    return _ok;
+
+  const uint32_t count = static_cast<uint32_t>(_values.size());
+  MACAddressSort::sort(_values.data(), count, _scratch.data());
+  const uint8_t *end = _encodeChunk(_values.data(), count, _bytes.data());
+
+  Entry entry;
+  entry.offset = _offset;
+  entry.first = _values.front().value();
+  entry.count = count;
+  entry.bytes = static_cast<uint32_t>(end - _bytes.data());
+  if (!_index.empty() && entry.first < _last)
+    _ordered = false;
+  _last = _values.back().value();
+  _index.push_back(entry);
+  _values.clear();
+
+  const MACAddressArchiveChunk chunk{entry.count, entry.bytes};
+  _write(&chunk, sizeof(chunk));
+  return _write(_bytes.data(), entry.bytes);
+}
+
+bool MACAddressArchive::Writer::add(MAC48 mac) {
+  if (_file == nullptr)
+    return false;
+
+  _values.push_back(mac);
+  ++_addresses;
+  return _values.size() != _chunk || _flush();
+}
+
+bool MACAddressArchive::Writer::add(const uint8_t octets[], size_t count) {
+  for (size_t i = 0; i != count; ++i)
+    if (!add(MAC48::fromOctets(octets + MACAddressBatch::octets_size * i)))
+      return false;
+  return true;
+}
+
+bool MACAddressArchive::Writer::close(void) {
+  if (_file == nullptr)
+    return false;
+
+  _flush();
+  MACAddressArchiveTrailer trailer;
+  trailer.index = _offset;
+  trailer.addresses = _addresses;
+  trailer.chunks = static_cast<uint32_t>(_index.size());
+  trailer.ordered = _ordered;
+  memcpy(trailer.magic, _magic, sizeof(_magic));
+  _write(_index.data(), sizeof(Entry) * _index.size());
+  _write(&trailer, sizeof(trailer));
+
+  if (_owned ? fclose(_file) != 0 : fflush(_file) != 0)
+    _ok = false;
+  _file = nullptr;
+  _owned = false;
+  _index.clear();
+  return _ok;
+}
+
+bool MACAddressArchive::Reader::open(const char *path) {
+  close();
+  _file = fopen(path, "rb");
+  if (_file == nullptr)
+    return false;
+
+  MACAddressArchiveHeader header;
+  MACAddressArchiveTrailer trailer;
+  bool ok = fread(&header, sizeof(header), 1, _file) == 1 &&
+            memcmp(header.magic, _magic, sizeof(_magic)) == 0 &&
+            header.endian == _endian &&
+            fseeko(_file, -static_cast<off_t>(sizeof(trailer)), SEEK_END) ==
+                0 &&
+            fread(&trailer, sizeof(trailer), 1, _file) == 1 &&
+            memcmp(trailer.magic, _magic, sizeof(_magic)) == 0;
+
+  // the index fills the file up to the trailer
+  const uint64_t length = ok ? static_cast<uint64_t>(ftello(_file)) : 0;
+  ok = ok && trailer.index >= sizeof(header) &&
+       trailer.index <= length - sizeof(trailer) &&
+       length - sizeof(trailer) - trailer.index ==
+           sizeof(Entry) * static_cast<uint64_t>(trailer.chunks) &&
+       fseeko(_file, static_cast<off_t>(trailer.index), SEEK_SET) == 0;
+  if (ok) {
+    _index.resize(trailer.chunks);
+    ok = trailer.chunks == 0 ||
+         fread(_index.data(), sizeof(Entry), trailer.chunks, _file) ==
+             trailer.chunks;
+  }
+
+  // and describes chunks of at most header.chunk addresses, one after the
+  // other
+  uint64_t addresses{0}, offset{sizeof(header)};
+  for (size_t i = 0; ok && i != _index.size(); ++i) {
+    const Entry &entry = _index[i];
+    ok = entry.offset == offset && entry.count != 0 &&
+         entry.count <= header.chunk &&
+         entry.bytes <= _encodedMax(entry.count);
+    addresses += entry.count;
+    offset += sizeof(MACAddressArchiveChunk) + entry.bytes;
+  }
+  if (!ok || offset != trailer.index || addresses != trailer.addresses) {
+    close();
+    return false;
+  }
+
+  _addresses = trailer.addresses;
+  _ordered = trailer.ordered != 0;
+  return seek(0);
+}
+
+void MACAddressArchive::Reader::close(void) {
+  if (_file != nullptr)
+    fclose(_file);
+  _file = nullptr;
+  _failed = false;
+  _ordered = false;
+  _addresses = 0;
+  _next = 0;
+  _position = 0;
+  _values.clear();
+  _index.clear();
+}
+
+bool MACAddressArchive::Reader::seek(uint32_t i) {
+  if (_file == nullptr || i > _index.size())
+    return false;
+
+  _next = i;
+  _position = 0;
+  _values.clear();
+  _failed = i != _index.size() &&
+            fseeko(_file, static_cast<off_t>(_index[i].offset), SEEK_SET) != 0;
+  return !_failed;
+}
+
+uint32_t MACAddressArchive::Reader::chunkOf(MAC48 mac) const {
+  // the first chunk starting after mac, then the one before it
+  size_t low{0}, high{_index.size()};
+  while (low != high) {
+    const size_t middle = low + (high - low) / 2;
+    if (_index[middle].first <= mac.value())
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return static_cast<uint32_t>(low == 0 ? _index.size() : low - 1);
+}
+
+bool MACAddressArchive::Reader::_decode(void) {
+  const Entry &entry = _index[_next];
+  MACAddressArchiveChunk chunk;
+  _bytes.resize(entry.bytes);
+  _values.resize(entry.count);
+  _position = 0;
+
+  if (fread(&chunk, sizeof(chunk), 1, _file) != 1 ||
+      chunk.count != entry.count || chunk.bytes != entry.bytes ||
+      fread(_bytes.data(), 1, entry.bytes, _file) != entry.bytes ||
+      !_decodeChunk(_bytes.data(), _bytes.data() + entry.bytes, entry.count,
+                    _values.data())) {
+    _failed = true;
+    _values.clear();
+    return false;
+  }
+
+  ++_next;
+  return true;
+}
+
+size_t MACAddressArchive::Reader::read(MAC48 macs[], size_t count) {
+  size_t n{0};
+  while (n != count && !_failed) {
+    if (_position == _values.size() &&
+        (_next == _index.size() || !_decode()))
+      break;
+
+    size_t available = _values.size() - _position;
+    if (available > count - n)
+      available = count - n;
+    memcpy(macs + n, _values.data() + _position, sizeof(MAC48) * available);
+    _position += available;
+    n += available;
+  }
+  return n;
+}
+
+size_t MACAddressArchive::Reader::read(uint8_t octets[], size_t count) {
+  MAC48 macs[256];
+  size_t n{0}, read_now;
+  do {
+    read_now = read(macs, count - n < 256 ? count - n : 256);
+    for (size_t i = 0; i != read_now; ++i)
+      macs[i].toOctets(octets + MACAddressBatch::octets_size * n++);
+  } while (read_now != 0 && n != count);
+  return n;
+}
+
+bool MACAddressArchive::Reader::read(MACAddress &mac) {
+  MAC48 value;
+  if (read(&value, 1) != 1)
+    return false;
+  mac = MACAddress{value};
+  return true;
+}
+
+#endif // MACADDRESS_HAS_STDIO
@@ -0,0 +1,178 @@
+#ifndef _MACAddressArchive_h_
+#define _MACAddressArchive_h_
+
+/*
+ *      @file: MACAddressArchive.h
+ *
+ * Only available on hosts (it reads and writes stdio files): not on the
+ * boards.
+ */
+
+#if !defined(ARDUINO)
+#define MACADDRESS_HAS_STDIO 1
+#endif
+
+#ifdef MACADDRESS_HAS_STDIO
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "MACAddress.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressArchive class stores large lists of addresses (inventory
+ * snapshots of millions of addresses) in a compact binary file: down to one
+ * byte per address for dense inventories, about six for scattered ones,
+ * instead of the 18 of a text line.
+ *
+ * The addresses are written in chunks of a fixed number of addresses (the
+ * last one excepted); every chunk is sorted (see MACAddressSort) and grouped
+ * by OUI (the first three octets): each group holds the difference from the
+ * previous OUI, the number of its addresses and the extension ids (the last
+ * three octets) as differences from the previous one, all of them LEB128
+ * varints. The denser the inventory, the smaller the differences.
+ *
+ * Writer and Reader are streaming: they hold a single chunk in memory, so
+ * that files of many GB are never resident. A small index of the chunks
+ * (offset and first address of each one) at the end of the file gives random
+ * access to a chunk; when the input was sorted the chunks follow each other
+ * in order and chunkOf() finds the only chunk which may hold an address.
+ *
+ *   MACAddressArchive::Writer writer;
+ *   writer.open("inventory.mpk");
+ *   writer.add(octets, count); // packed 6-byte addresses (MACAddressBatch)
+ *   writer.add(mac);           // a MACAddress, or a MAC48
+ *   writer.close();
+ *
+ *   MACAddressArchive::Reader reader;
+ *   reader.open("inventory.mpk");
+ *   while ((n = reader.read(macs, 1024)) != 0)
+ *     ...
+ *
+ * Files are written in the host byte order (checked when read back).
+ */
+class MACAddressArchive {
+private:
+  // Index entry of a chunk
+  struct Entry {
+    uint64_t offset; // of the chunk header
+    uint64_t first;  // value of the first (lowest) address of the chunk
+    uint32_t count;
+    uint32_t bytes; // of the encoded addresses
+  };
+
+public:
+  // Default number of addresses per chunk
+  static const uint32_t chunk_size{65536};
+
+  class Writer {
+  public:
+    explicit Writer(uint32_t chunk = chunk_size);
+    ~Writer(void) { close(); }
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    // Creates (or truncates) path, false if it cannot be written
+    bool open(const char *path);
+    // Writes to an open file (e.g. stdout), left open by close()
+    bool open(FILE *file);
+
+    bool add(MAC48 mac);
+    bool add(const MACAddress &mac) { return add(mac.toMAC48()); }
+    // Packed 6-byte addresses (address i at octets + 6 * i)
+    bool add(const uint8_t octets[], size_t count);
+
+    /*
+     * Writes the last chunk and the index.
+     * @return: false if any write failed (the file is then not valid).
+     */
+    bool close(void);
+
+    // Number of addresses added
+    uint64_t size(void) const { return _addresses; }
+
+  private:
+    FILE *_file{nullptr};
+    bool _owned{false};
+    bool _ok{false};
+    bool _ordered{true};
+    uint32_t _chunk;
+    uint64_t _offset{0};
+    uint64_t _addresses{0};
+    uint64_t _last{0}; // value of the last address of the previous chunk
+    std::vector<MAC48> _values;
+    std::vector<MAC48> _scratch;
+    std::vector<uint8_t> _bytes;
+    std::vector<Entry> _index;
+
+    bool _write(const void *data, size_t size);
+    bool _flush(void);
+  };
+
+  class Reader {
+  public:
+    Reader(void) {}
+    ~Reader(void) { close(); }
+
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    // Opens an archive, false if it cannot be read or is not valid
+    bool open(const char *path);
+    void close(void);
+    bool isOpen(void) const { return _file != nullptr; }
+
+    /*
+     * Reads the next count addresses at most, in the order of the file
+     * (sorted within each chunk).
+     * @return: the number of addresses read, 0 at the end of the file or on
+     *          a corrupted chunk (see failed()).
+     */
+    size_t read(MAC48 macs[], size_t count);
+    size_t read(uint8_t octets[], size_t count);
+    bool read(MACAddress &mac);
+
+    bool failed(void) const { return _failed; }
+
+    // Number of addresses and chunks of the archive
+    uint64_t size(void) const { return _addresses; }
+    uint32_t chunks(void) const {
+      return static_cast<uint32_t>(_index.size());
+    }
+
+    // First address and number of addresses of chunk i (i < chunks())
+    MAC48 first(uint32_t i) const { return MAC48{_index[i].first}; }
+    uint32_t count(uint32_t i) const { return _index[i].count; }
+
+    // True if the chunks follow each other in order (a sorted input)
+    bool ordered(void) const { return _ordered; }
+
+    /*
+     * The chunk which may hold mac in an ordered archive: the last one whose
+     * first address is not greater (chunks() if mac precedes every chunk).
+     */
+    uint32_t chunkOf(MAC48 mac) const;
+
+    // The next read() starts from the first address of chunk i
+    bool seek(uint32_t i);
+
+  private:
+    FILE *_file{nullptr};
+    bool _failed{false};
+    bool _ordered{false};
+    uint64_t _addresses{0};
+    uint32_t _next{0}; // next chunk to decode
+    size_t _position{0};
+    std::vector<MAC48> _values; // the decoded chunk, from _position on
+    std::vector<uint8_t> _bytes;
+    std::vector<Entry> _index;
+
+    bool _decode(void);
+  };
+};
+
+#endif // MACADDRESS_HAS_STDIO
+
+#endif // _MACAddressArchive_h_
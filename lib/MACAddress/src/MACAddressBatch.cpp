@@ -0,0 +1,436 @@
+/*
+ *      @file: MACAddressBatch.cpp
+ */
+
+#include "MACAddressBatch.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define MACADDRESS_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Length of a canonical entry: AB:CD:EF:01:23:45
+static const uint8_t _canonical{17};
+
+/*
+    Returns true if a canonical entry may start at p, i.e. if it is followed by
+    a separator or by the end of the text; next is then set to the beginning of
+    the following entry.
+ */
+static inline bool _candidate(const char *p, const char *end,
+                              const char *&next) {
+  if (end - p < _canonical)
+    return false;
+
+  const char *d = p + _canonical;
+  if (d == end) {
+    next = d;
+    return true;
+  }
+
+  char c = *d;
+  if (c == '\n' || c == ',') {
+    next = d + 1;
+    return true;
+  }
+  if (c == '\r' && d + 1 != end && d[1] == '\n') {
+    next = d + 2;
+    return true;
+  }
+
+  return false;
+}
+
+/*
+    Entries are decoded in order, so the first bit of every byte of the bitmap
+    resets the whole byte: the bitmap does not need to be cleared in advance.
+ */
+static inline void _writeValid(uint8_t valid[], size_t i, bool value) {
+  const uint8_t bit = static_cast<uint8_t>(value << (i & 7));
+  if ((i & 7) == 0)
+    valid[i >> 3] = bit;
+  else
+    valid[i >> 3] |= bit;
+}
+
+#ifdef MACADDRESS_BATCH_X86
+
+#define MACADDRESS_TARGET_SSE __attribute__((target("sse4.1")))
+#define MACADDRESS_TARGET_AVX2 __attribute__((target("avx2")))
+
+/*
+    Canonical entries have the high nibbles at 0, 3, 6, 9, 12, 15 and the low
+    ones at the same offsets from p + 1; the separators at 2, 5, 8, 11, 14.
+ */
+static const uint32_t _separators_mask{0x4924};
+static const uint32_t _nibbles_mask{0x3F3F}; // hi nibbles: 0-5, lo ones: 8-13
+
+MACADDRESS_TARGET_SSE static inline __m128i _nibbleIndexes(void) {
+  return _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                       -1);
+}
+
+/*
+    Converts 16 characters to their hexadecimal values; valid receives the
+    movemask of the lanes holding a hexadecimal digit.
+ */
+MACADDRESS_TARGET_SSE static inline __m128i _hexToNibbles(__m128i c,
+                                                          uint32_t &valid) {
+  const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+  const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+  const __m128i l =
+      _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i is_letter =
+      _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+
+  valid = static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)));
+
+  return _mm_blendv_epi8(_mm_add_epi8(l, _mm_set1_epi8(10)), d, is_digit);
+}
+
+MACADDRESS_TARGET_SSE static inline bool _decodeSSE(const char *p,
+                                                    uint8_t octets[]) {
+  const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 1));
+
+  const uint32_t colons =
+      static_cast<uint32_t>(_mm_movemask_epi8(
+          _mm_cmpeq_epi8(a, _mm_set1_epi8(':')))) &
+      _separators_mask;
+  const uint32_t dashes =
+      static_cast<uint32_t>(_mm_movemask_epi8(
+          _mm_cmpeq_epi8(a, _mm_set1_epi8('-')))) &
+      _separators_mask;
+  if (colons != _separators_mask && dashes != _separators_mask)
+    return false;
+
+  const __m128i idx = _nibbleIndexes();
+  const __m128i hex = _mm_unpacklo_epi64(_mm_shuffle_epi8(a, idx),
+                                         _mm_shuffle_epi8(b, idx));
+  uint32_t valid;
+  const __m128i v = _hexToNibbles(hex, valid);
+  if ((valid & _nibbles_mask) != _nibbles_mask)
+    return false;
+
+  const __m128i bytes =
+      _mm_or_si128(_mm_slli_epi16(v, 4), _mm_srli_si128(v, 8));
+  const uint64_t x = static_cast<uint64_t>(_mm_cvtsi128_si64(bytes));
+  memcpy(octets, &x, MACAddressBatch::octets_size);
+
+  return true;
+}
+
+/*
+    Decodes the canonical entries at p and q at once.
+    @return: bit 0 set if p has been decoded, bit 1 if q has.
+ */
+MACADDRESS_TARGET_AVX2 static inline uint32_t
+_decodeAVX2(const char *p, const char *q, uint8_t octets[]) {
+  const __m256i a = _mm256_loadu2_m128i(reinterpret_cast<const __m128i *>(q),
+                                        reinterpret_cast<const __m128i *>(p));
+  const __m256i b =
+      _mm256_loadu2_m128i(reinterpret_cast<const __m128i *>(q + 1),
+                          reinterpret_cast<const __m128i *>(p + 1));
+
+  const uint32_t colons = static_cast<uint32_t>(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(a, _mm256_set1_epi8(':'))));
+  const uint32_t dashes = static_cast<uint32_t>(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(a, _mm256_set1_epi8('-'))));
+
+  const __m256i idx = _mm256_setr_epi8(
+      0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, //
+      0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i c = _mm256_unpacklo_epi64(_mm256_shuffle_epi8(a, idx),
+                                          _mm256_shuffle_epi8(b, idx));
+
+  const __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+  const __m256i is_digit =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+  const __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)),
+                                    _mm256_set1_epi8('a'));
+  const __m256i is_letter =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+  const uint32_t hex = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)));
+  const __m256i v = _mm256_blendv_epi8(
+      _mm256_add_epi8(l, _mm256_set1_epi8(10)), d, is_digit);
+  const __m256i bytes =
+      _mm256_or_si256(_mm256_slli_epi16(v, 4), _mm256_srli_si256(v, 8));
+
+  uint32_t rc{0};
+  for (uint8_t lane = 0; lane != 2; ++lane) {
+    const uint8_t shift = 16 * lane;
+    if ((((colons >> shift) & _separators_mask) != _separators_mask &&
+         ((dashes >> shift) & _separators_mask) != _separators_mask) ||
+        ((hex >> shift) & _nibbles_mask) != _nibbles_mask)
+      continue;
+
+    const uint64_t x = static_cast<uint64_t>(
+        lane ? _mm256_extract_epi64(bytes, 2) : _mm256_extract_epi64(bytes, 0));
+    memcpy(octets + lane * MACAddressBatch::octets_size, &x,
+           MACAddressBatch::octets_size);
+    rc |= 1u << lane;
+  }
+
+  return rc;
+}
+
+/*
+    The fast runs decode consecutive canonical entries, stopping at the first
+    one they cannot handle (left to the scanner) or when n reaches capacity.
+ */
+MACADDRESS_TARGET_SSE static size_t _runSSE(const char *&p, const char *end,
+                                            uint8_t octets[], uint8_t valid[],
+                                            size_t n, size_t capacity) {
+  const size_t first = n;
+  const char *next;
+
+  while (n != capacity && _candidate(p, end, next) &&
+         _decodeSSE(p, octets + n * MACAddressBatch::octets_size)) {
+    _writeValid(valid, n++, true);
+    p = next;
+  }
+
+  return n - first;
+}
+
+MACADDRESS_TARGET_AVX2 static size_t _runAVX2(const char *&p, const char *end,
+                                              uint8_t octets[],
+                                              uint8_t valid[], size_t n,
+                                              size_t capacity) {
+  const size_t first = n;
+  const char *q, *next;
+
+  while (n != capacity && _candidate(p, end, q)) {
+    uint8_t *out = octets + n * MACAddressBatch::octets_size;
+
+    if (n + 1 != capacity && _candidate(q, end, next)) {
+      uint32_t decoded = _decodeAVX2(p, q, out);
+      if (decoded == 3) {
+        _writeValid(valid, n++, true);
+        _writeValid(valid, n++, true);
+        p = next;
+        continue;
+      }
+      if (decoded == 1) {
+        _writeValid(valid, n++, true);
+        p = q;
+      }
+      break;
+    }
+
+    if (!_decodeSSE(p, out))
+      break;
+    _writeValid(valid, n++, true);
+    p = q;
+  }
+
+  return n - first;
+}
+
+/*
+    Writes address i as hexadecimal digits: lanes 0-11 hold h0 l0 h1 l1 ... h5
+    l5 (the high and low nibbles of every octet).
+ */
+MACADDRESS_TARGET_SSE static inline __m128i _toHexDigits(__m128i v) {
+  const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+  const __m128i low = _mm_set1_epi8(0x0F);
+  const __m128i nibbles = _mm_unpacklo_epi8(
+      _mm_and_si128(_mm_srli_epi16(v, 4), low), _mm_and_si128(v, low));
+  return _mm_shuffle_epi8(digits, nibbles);
+}
+
+// Places the digits 0-10 at their offset in a canonical entry
+MACADDRESS_TARGET_SSE static inline __m128i _layout(void) {
+  return _mm_setr_epi8(0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10);
+}
+
+MACADDRESS_TARGET_SSE static inline __m128i _separators(char separator) {
+  const char s = separator;
+  return _mm_setr_epi8(0, 0, s, 0, 0, s, 0, 0, s, 0, 0, s, 0, 0, s, 0);
+}
+
+// Loads six octets without reading past them (nor going through the stack)
+static inline uint64_t _load6(const uint8_t octets[]) {
+  uint32_t low;
+  uint16_t high;
+  memcpy(&low, octets, sizeof(low));
+  memcpy(&high, octets + sizeof(low), sizeof(high));
+  return low | (static_cast<uint64_t>(high) << 32);
+}
+
+static inline uint64_t _load8(const uint8_t octets[]) {
+  uint64_t x;
+  memcpy(&x, octets, sizeof(x));
+  return x;
+}
+
+MACADDRESS_TARGET_SSE static char *_formatSSE(const uint8_t octets[],
+                                              size_t count, char separator,
+                                              char delimiter, char *out) {
+  const __m128i layout = _layout();
+  const __m128i separators = _separators(separator);
+
+  for (size_t i = 0; i != count; ++i, octets += MACAddressBatch::octets_size) {
+    const __m128i digits = _toHexDigits(
+        _mm_cvtsi64_si128(static_cast<long long>(_load6(octets))));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(out),
+        _mm_or_si128(_mm_shuffle_epi8(digits, layout), separators));
+    out[16] = static_cast<char>(_mm_extract_epi8(digits, 11));
+    out[17] = delimiter;
+    out += MACAddressFormat::size + 1;
+  }
+
+  return out;
+}
+
+MACADDRESS_TARGET_AVX2 static char *_formatAVX2(const uint8_t octets[],
+                                                size_t count, char separator,
+                                                char delimiter, char *out) {
+  const char s = separator;
+  const __m256i digits_lut =
+      _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A',
+                       'B', 'C', 'D', 'E', 'F', '0', '1', '2', '3', '4', '5',
+                       '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+  const __m256i layout = _mm256_setr_epi8(
+      0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10, //
+      0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10);
+  const __m256i separators =
+      _mm256_setr_epi8(0, 0, s, 0, 0, s, 0, 0, s, 0, 0, s, 0, 0, s, 0, //
+                       0, 0, s, 0, 0, s, 0, 0, s, 0, 0, s, 0, 0, s, 0);
+  const __m256i low = _mm256_set1_epi8(0x0F);
+  const size_t stride = MACAddressFormat::size + 1;
+
+  size_t i{0};
+  for (; i + 2 <= count; i += 2, octets += 2 * MACAddressBatch::octets_size) {
+    // the 12 octets of the pair: the two extra bytes of the first load only
+    // produce digits which are never stored
+    const __m256i v =
+        _mm256_setr_epi64x(static_cast<long long>(_load8(octets)), 0,
+                           static_cast<long long>(_load8(octets + 4) >> 16), 0);
+    const __m256i digits = _mm256_shuffle_epi8(
+        digits_lut,
+        _mm256_unpacklo_epi8(_mm256_and_si256(_mm256_srli_epi16(v, 4), low),
+                             _mm256_and_si256(v, low)));
+    const __m256i text = _mm256_or_si256(
+        _mm256_shuffle_epi8(digits, layout), separators);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                     _mm256_castsi256_si128(text));
+    out[16] = static_cast<char>(_mm256_extract_epi8(digits, 11));
+    out[17] = delimiter;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + stride),
+                     _mm256_extracti128_si256(text, 1));
+    out[stride + 16] = static_cast<char>(_mm256_extract_epi8(digits, 27));
+    out[stride + 17] = delimiter;
+    out += 2 * stride;
+  }
+
+  return _formatSSE(octets, count - i, separator, delimiter, out);
+}
+
+typedef char *(*_format_t)(const uint8_t[], size_t, char, char, char *);
+
+static _format_t _selectFormat(void) {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return _formatAVX2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return _formatSSE;
+  return nullptr;
+}
+
+typedef size_t (*_run_t)(const char *&, const char *, uint8_t[], uint8_t[],
+                         size_t, size_t);
+
+static _run_t _selectRun(void) {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return _runAVX2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return _runSSE;
+  return nullptr;
+}
+
+#endif // MACADDRESS_BATCH_X86
+
+bool MACAddressBatch::_parseEntry(const char *&p, const char *end,
+                                  uint8_t octets[]) {
+  const char *e = p;
+  while (e != end && *e != '\n' && *e != ',')
+    ++e;
+
+  const char *stop = e;
+  if (e != end && *e == '\n' && stop != p && stop[-1] == '\r')
+    --stop;
+
+  MACAddressParser::SliceSource source{p, stop};
+  MACAddressParser::OctetWriter sink{octets};
+  bool rc = MACAddressParser::Status::OK ==
+                MACAddressParser::scan(source, sink) &&
+            source.p == stop;
+
+  if (!rc)
+    memset(octets, 0xFF, octets_size);
+
+  p = e == end ? end : e + 1;
+
+  return rc;
+}
+
+size_t MACAddressBatch::parse(const char text[], size_t length,
+                              uint8_t octets[], uint8_t valid[],
+                              size_t capacity, size_t *consumed) {
+  const char *p = text;
+  const char *end = text + length;
+  size_t n{0};
+
+#ifdef MACADDRESS_BATCH_X86
+  static const _run_t run = _selectRun();
+#endif
+
+  while (p != end && n != capacity) {
+#ifdef MACADDRESS_BATCH_X86
+    if (run) {
+      const size_t decoded = run(p, end, octets, valid, n, capacity);
+      n += decoded;
+      if (decoded)
+        continue;
+    }
+#endif
+    _writeValid(valid, n, _parseEntry(p, end, octets + n * octets_size));
+    ++n;
+  }
+
+  if (consumed)
+    *consumed = static_cast<size_t>(p - text);
+
+  return n;
+}
+
+size_t MACAddressBatch::format(const uint8_t octets[], size_t count,
+                               Representation representation, char text[],
+                               char separator) {
+  char *out = text;
+
+#ifdef MACADDRESS_BATCH_X86
+  static const _format_t fixed = _selectFormat();
+
+  if (fixed && representation != Representation::COMMON_COMPACT)
+    return static_cast<size_t>(
+        fixed(octets, count,
+              representation == Representation::EUI48 ? '-' : ':', separator,
+              out) -
+        text);
+#endif
+
+  for (size_t i = 0; i != count; ++i, octets += octets_size) {
+    out = MACAddressFormat::write(out, octets, representation);
+    *out++ = separator;
+  }
+
+  return static_cast<size_t>(out - text);
+}
@@ -0,0 +1,108 @@
+#ifndef _MACAddressBatch_h_
+#define _MACAddressBatch_h_
+
+/*
+ *      @file: MACAddressBatch.h
+ *
+ * Bulk conversions between text lists of addresses and packed 6-byte arrays.
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+#include "MACAddressFormat.h"
+#include "MACAddressParser.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressBatch class works on many addresses at once, without
+ * constructing any MACAddress object and without any heap allocation.
+ *
+ * Addresses are packed: address i takes the six bytes starting at
+ * octets[6 * i], in transmission order (the same layout of MACAddress's
+ * uint8_t * cast).
+ *
+ * On x86-64 the canonical 17 characters entries (AB:CD:EF:01:23:45 and
+ * AB-CD-EF-01-23-45) are decoded with SSE4.1 (one entry per step) or AVX2 (two
+ * entries per step), selected at run time; everything else, and every entry on
+ * the other architectures, goes through the MACAddressParser scanner, so that
+ * the accepted entries are exactly the ones accepted by MACAddress::fromString.
+ *
+ * The formatter works the other way around: COMMON_FULL and EUI48 entries
+ * have a fixed width and their nibbles are converted to hexadecimal digits 16
+ * (SSE4.1) or 32 (AVX2) at a time; COMMON_COMPACT entries have a variable
+ * width and are written by the scalar MACAddressFormat core.
+ */
+class MACAddressBatch {
+public:
+  static const uint8_t octets_size{6};
+
+  /*
+   * Parses the list of addresses in text (which does not need to be NUL
+   * terminated), separated by new lines ("\n" or "\r\n") or commas; each entry
+   * is decoded into octets and its validity is stored in the bitmap valid
+   * (bit i % 8 of valid[i / 8], set if the entry i is an address; the unused
+   * bits of the last byte are cleared).
+   * Invalid entries are stored as FF:FF:FF:FF:FF:FF, as fromString() does.
+   *
+   * At most capacity entries are decoded; consumed (if requested) is set to
+   * the number of characters read, so that long lists can be parsed in chunks.
+   * When streaming, pass only complete entries: the text after the last
+   * separator is parsed as an entry as well.
+   *
+   * @return: the number of entries decoded.
+   */
+  static size_t parse(const char text[], size_t length, uint8_t octets[],
+                      uint8_t valid[], size_t capacity,
+                      size_t *consumed = nullptr);
+
+  // Maximum number of characters written by format() for count addresses
+  static size_t formatSize(size_t count) {
+    return count * (MACAddressFormat::size + 1);
+  }
+
+  /*
+   * Writes count packed addresses into text, each one followed by separator
+   * (no NUL terminator is added); text must be able to hold
+   * formatSize(count) characters.
+   *
+   * @return: the number of characters written.
+   */
+  static size_t format(const uint8_t octets[], size_t count,
+                       Representation representation, char text[],
+                       char separator = '\n');
+
+  // Returns true if the entry i is marked as valid in the bitmap valid
+  static bool isValid(const uint8_t valid[], size_t i) {
+    return valid[i >> 3] & (1 << (i & 7));
+  }
+
+  /*
+   * Writes count addresses into the packed array octets, address i being the
+   * 48 bits value returned by the i-th call of next(); on little endian 64
+   * bits hosts every address but the last one takes a single unaligned store
+   * of 8 bytes, the two extra bytes being overwritten by the next address.
+   */
+  template <typename F>
+  static void pack(uint8_t octets[], size_t count, F next) {
+    size_t i{0};
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ &&   \
+    __SIZEOF_SIZE_T__ == 8
+    for (; i + 1 < count; ++i) {
+      const uint64_t word = __builtin_bswap64(next() << 16);
+      memcpy(octets + octets_size * i, &word, sizeof(word));
+    }
+#endif
+    for (; i != count; ++i)
+      MAC48{next()}.toOctets(octets + octets_size * i);
+  }
+
+  // Writes count consecutive 48 bits values from first on into octets
+  static void pack(uint8_t octets[], size_t count, uint64_t first) {
+    pack(octets, count, [&first] { return first++; });
+  }
+
+private:
+  static bool _parseEntry(const char *&p, const char *end, uint8_t octets[]);
+};
+
+#endif // _MACAddressBatch_h_
@@ -0,0 +1,366 @@
+/*
+ *      @file: MACAddressCapture.cpp
+ */
+
+#include "MACAddressCapture.h"
+
+#if defined(MACADDRESS_HAS_MMAP) && defined(MACADDRESS_HAS_THREAD)
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <thread>
+
+// pcap: file header magic numbers (micro and nanosecond timestamps)
+static const uint32_t _pcap_us{0xA1B2C3D4};
+static const uint32_t _pcap_ns{0xA1B23C4D};
+static const size_t _pcap_header{24};
+static const size_t _pcap_record{16};
+static const uint32_t _max_length{0x40000}; // larger than any frame
+
+// pcapng: block types and byte order magic of the section header block
+static const uint32_t _shb{0x0A0D0D0A};
+static const uint32_t _idb{0x00000001};
+static const uint32_t _opb{0x00000002}; // obsolete packet block
+static const uint32_t _spb{0x00000003};
+static const uint32_t _epb{0x00000006};
+static const size_t _min_block{12};
+static const uint32_t _byte_order{0x1A2B3C4D};
+
+static const uint16_t _ethernet{1}; // LINKTYPE_ETHERNET
+static const size_t _addresses_size{12}; // destination and source
+
+MACAddressTraffic &MACAddressTraffic::operator+=(
+    const MACAddressTraffic &traffic) {
+  tx_frames += traffic.tx_frames;
+  tx_bytes += traffic.tx_bytes;
+  rx_frames += traffic.rx_frames;
+  rx_bytes += traffic.rx_bytes;
+  return *this;
+}
+
+uint32_t MACAddressCapture::_read32(size_t offset, bool swap) const {
+  uint32_t n;
+  memcpy(&n, _map + offset, sizeof(n));
+  return swap ? __builtin_bswap32(n) : n;
+}
+
+uint16_t MACAddressCapture::_read16(size_t offset, bool swap) const {
+  uint16_t n;
+  memcpy(&n, _map + offset, sizeof(n));
+  return swap ? __builtin_bswap16(n) : n;
+}
+
+bool MACAddressCapture::open(const char *path) {
+  close();
+
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  void *map{MAP_FAILED};
+  if (0 == fstat(fd, &st) && st.st_size >= static_cast<off_t>(_pcap_header))
+    map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  _map = static_cast<const uint8_t *>(map);
+  _length = st.st_size;
+
+  const uint32_t magic = _read32(0, false);
+  if (magic == _pcap_us || magic == _pcap_ns ||
+      magic == __builtin_bswap32(_pcap_us) ||
+      magic == __builtin_bswap32(_pcap_ns)) {
+    _format = Format::PCAP;
+    _swap = magic != _pcap_us && magic != _pcap_ns;
+    _nano = _read32(0, _swap) == _pcap_ns;
+    _snaplen = _read32(16, _swap);
+    _link = _read32(20, _swap) & 0xFFFF;
+    _first = _pcap_header;
+  } else if (magic == _shb && (_read32(8, false) == _byte_order ||
+                               _read32(8, true) == _byte_order)) {
+    _format = Format::PCAPNG;
+    _first = 0;
+  } else {
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+void MACAddressCapture::close(void) {
+  if (_map != nullptr)
+    munmap(const_cast<uint8_t *>(_map), _length);
+
+  _map = nullptr;
+  _length = 0;
+  _format = Format::NONE;
+}
+
+// Length of the pcapng block at pos, 0 if it is truncated or corrupted
+size_t MACAddressCapture::_block(size_t pos, bool swap) const {
+  if (_length - pos < _min_block)
+    return 0;
+
+  const uint32_t total = _read32(pos + 4, swap);
+  if (total < _min_block || (total & 3) || total > _length - pos ||
+      _read32(pos + total - 4, swap) != total)
+    return 0;
+  return total;
+}
+
+// True if a chain of valid headers starts at pos (or the file ends there)
+bool MACAddressCapture::_plausible(size_t pos,
+                                   const Section &section) const {
+  if (_format == Format::PCAP) {
+    const uint32_t max_captured = _snaplen > _max_length ? _snaplen
+                                                         : _max_length;
+    const uint32_t max_fraction = _nano ? 1000000000 : 1000000;
+    uint32_t seconds{0};
+    for (uint8_t i = 0; i != _sync_records && pos != _length; ++i) {
+      if (_length - pos < _pcap_record)
+        return false;
+
+      // stricter than _walk(): records of empty frames are not expected
+      const uint32_t ts = _read32(pos, _swap);
+      const uint32_t captured = _read32(pos + 8, _swap);
+      const uint32_t length = _read32(pos + 12, _swap);
+      if (_read32(pos + 4, _swap) >= max_fraction || captured == 0 ||
+          captured > max_captured || captured > length ||
+          length > _max_length ||
+          captured > _length - pos - _pcap_record ||
+          (i != 0 && (ts - seconds + 86400u) > 2 * 86400u))
+        return false;
+
+      seconds = ts;
+      pos += _pcap_record + captured;
+    }
+    return true;
+  }
+
+  for (uint8_t i = 0; i != _sync_records && pos != _length; ++i) {
+    const size_t total = _block(pos, section.swap);
+    if (total == 0)
+      return false;
+    pos += total;
+  }
+  return true;
+}
+
+// First plausible record (or block) boundary from pos on, _length if none
+size_t MACAddressCapture::_sync(size_t pos, const Section &section) const {
+  if (_format == Format::PCAPNG)
+    pos = (pos + 3) & ~static_cast<size_t>(3); // blocks are 32 bits aligned
+
+  const size_t step = _format == Format::PCAPNG ? 4 : 1;
+  for (; pos < _length; pos += step)
+    if (_plausible(pos, section))
+      return pos;
+  return _length;
+}
+
+/*
+ * Counts the records starting in [pos, limit), stopping at the first invalid
+ * one; returns where the walk stopped (the first record at or past limit).
+ */
+size_t MACAddressCapture::_walk(size_t pos, size_t limit, Section &section,
+                                Partial &partial) const {
+  if (_format == Format::PCAP) {
+    while (pos < limit && _length - pos >= _pcap_record) {
+      const uint32_t captured = _read32(pos + 8, _swap);
+      if (captured > _length - pos - _pcap_record)
+        break; // truncated
+
+      if (_link == _ethernet)
+        _count(_map + pos + _pcap_record, captured, _read32(pos + 12, _swap),
+               partial);
+      else
+        ++partial.skipped;
+      pos += _pcap_record + captured;
+    }
+    return pos;
+  }
+
+  while (pos < limit) {
+    const uint32_t type = _read32(pos, section.swap); // SHB: palindromic
+    bool swap = section.swap;
+    if (type == _shb && _length - pos >= _min_block)
+      swap = _read32(pos + 8, false) != _byte_order;
+
+    const size_t total = _block(pos, swap);
+    if (total == 0)
+      break; // truncated or corrupted
+
+    uint32_t interface{0}, captured{0}, length{0};
+    size_t data{0};
+    if (type == _shb) {
+      if (total < 16 || _read32(pos + 8, swap) != _byte_order)
+        break;
+      section.swap = swap;
+      section.links.clear();
+    } else if (type == _idb && total >= 20)
+      section.links.push_back(_read16(pos + 8, swap));
+    else if ((type == _epb || type == _opb) && total >= 32) {
+      interface =
+          type == _epb ? _read32(pos + 8, swap) : _read16(pos + 8, swap);
+      captured = _read32(pos + 20, swap);
+      length = _read32(pos + 24, swap);
+      data = 28;
+    } else if (type == _spb && total >= 16) {
+      length = _read32(pos + 8, swap);
+      captured = length < total - 16 ? length : total - 16;
+      data = 12;
+    }
+
+    if (data != 0) {
+      if (captured > total - data - 4)
+        captured = total - data - 4; // never past the block
+      if (interface < section.links.size() &&
+          section.links[interface] == _ethernet)
+        _count(_map + pos + data, captured, length, partial);
+      else
+        ++partial.skipped;
+    }
+
+    pos += total;
+  }
+  return pos;
+}
+
+void MACAddressCapture::_count(const uint8_t frame[], size_t captured,
+                               uint32_t length, Partial &partial) {
+  if (captured < _addresses_size) {
+    ++partial.skipped;
+    return;
+  }
+
+  const MAC48 destination = MAC48::fromOctets(frame);
+  const MAC48 source = MAC48::fromOctets(frame + 6);
+
+  ++partial.frames;
+  partial.bytes += length;
+
+  // one lookup at a time: an insertion may move the other entries
+  MACAddressTraffic *traffic = partial.addresses.emplace(destination);
+  ++traffic->rx_frames;
+  traffic->rx_bytes += length;
+  traffic = partial.ouis.emplace(destination.withExtensionId24(0));
+  ++traffic->rx_frames;
+  traffic->rx_bytes += length;
+
+  traffic = partial.addresses.emplace(source);
+  ++traffic->tx_frames;
+  traffic->tx_bytes += length;
+  traffic = partial.ouis.emplace(source.withExtensionId24(0));
+  ++traffic->tx_frames;
+  traffic->tx_bytes += length;
+}
+
+void MACAddressCapture::_merge(MACAddressMap<MACAddressTraffic> &to,
+                               const MACAddressMap<MACAddressTraffic> &from) {
+  from.forEach([&](MAC48 mac, const MACAddressTraffic &traffic) {
+    *to.emplace(mac) += traffic;
+  });
+}
+
+uint64_t MACAddressCapture::analyze(unsigned threads) {
+  _addresses = MACAddressMap<MACAddressTraffic>{};
+  _ouis = MACAddressMap<MACAddressTraffic>{};
+  _frames = _bytes = _skipped = 0;
+  if (_map == nullptr)
+    return 0;
+
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads > (_length - _first) / _min_range)
+    threads = static_cast<unsigned>((_length - _first) / _min_range);
+  if (threads == 0)
+    threads = 1;
+
+  // pcapng: the section of the first frames, assumed by every range but the
+  // first one (the walk of the leading SHB and IDB blocks)
+  Section initial;
+  if (_format == Format::PCAPNG) {
+    Partial none;
+    for (size_t pos{_first}, next; pos < _length; pos = next) {
+      const uint32_t type = _read32(pos, initial.swap);
+      if ((type != _shb && type != _idb) ||
+          (next = _walk(pos, pos + 1, initial, none)) == pos)
+        break;
+    }
+  }
+
+  std::vector<size_t> starts(threads + 1);
+  starts[0] = _first;
+  starts[threads] = _length;
+  for (unsigned t = 1; t < threads; ++t) {
+    starts[t] = _sync(_first + (_length - _first) / threads * t, initial);
+    if (starts[t] < starts[t - 1])
+      starts[t] = starts[t - 1];
+  }
+
+  std::vector<Partial> partials(threads);
+  auto work = [&](unsigned t) {
+    Partial &partial = partials[t];
+    if (t != 0)
+      partial.first = initial;
+    partial.last = partial.first;
+    partial.end = _walk(starts[t], starts[t + 1], partial.last, partial);
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(work, t);
+  work(0);
+  for (std::thread &thread : pool)
+    thread.join();
+
+  // check that every range starts where the previous one ended, walking
+  // again (into fix) the ones which do not
+  Partial fix;
+  size_t pos{partials[0].end};
+  Section section{partials[0].last};
+  std::vector<bool> valid(threads, true);
+  for (unsigned t = 1; t < threads; ++t) {
+    if (pos < starts[t]) {
+      // the file ends (or is corrupted) before this range
+      for (; t < threads; ++t)
+        valid[t] = false;
+      break;
+    }
+
+    if (pos == starts[t] && section == partials[t].first) {
+      pos = partials[t].end;
+      section = partials[t].last;
+    } else {
+      valid[t] = false;
+      pos = _walk(pos, starts[t + 1], section, fix);
+    }
+  }
+
+  _addresses = partials[0].addresses;
+  _ouis = partials[0].ouis;
+  for (unsigned t = 0; t <= threads; ++t) {
+    const Partial &partial = t == threads ? fix : partials[t];
+    if (t != threads && !valid[t])
+      continue;
+
+    if (t != 0) {
+      _merge(_addresses, partial.addresses);
+      _merge(_ouis, partial.ouis);
+    }
+    _frames += partial.frames;
+    _bytes += partial.bytes;
+    _skipped += partial.skipped;
+  }
+
+  return _frames;
+}
+
+#endif // MACADDRESS_HAS_MMAP && MACADDRESS_HAS_THREAD
@@ -0,0 +1,162 @@
+#ifndef _MACAddressCapture_h_
+#define _MACAddressCapture_h_
+
+/*
+ *      @file: MACAddressCapture.h
+ *
+ * Only available on POSIX hosts providing <thread> (it memory maps files and
+ * spreads the work among threads): not on the boards.
+ */
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define MACADDRESS_HAS_MMAP 1
+#endif
+
+#if defined(__has_include)
+#if __has_include(<thread>)
+#define MACADDRESS_HAS_THREAD 1
+#endif
+#endif
+
+#if defined(MACADDRESS_HAS_MMAP) && defined(MACADDRESS_HAS_THREAD)
+
+#include <vector>
+
+#include "MAC48.h"
+#include "MACAddressMap.h"
+
+// Traffic of an address (or of the addresses of an OUI)
+struct MACAddressTraffic {
+  uint64_t tx_frames{0}; // frames sent (source address)
+  uint64_t tx_bytes{0};
+  uint64_t rx_frames{0}; // frames received (destination address)
+  uint64_t rx_bytes{0};
+
+  MACAddressTraffic &operator+=(const MACAddressTraffic &traffic);
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressCapture class computes the traffic of every address found in
+ * the Ethernet frames of a capture file (pcap, with micro or nanosecond
+ * timestamps, or pcapng, in either byte order).
+ *
+ * open() memory maps the file; analyze() splits it in one range of bytes per
+ * worker thread. Each thread finds the first record (pcap) or block (pcapng)
+ * of its range, recognized by a chain of plausible headers, then counts the
+ * frames and bytes (the original length on the wire) of the source and
+ * destination addresses of the records starting within its range into its
+ * own tables. The threads share nothing while they work, so the analysis
+ * scales with the number of cores; no serial pass over the file is needed.
+ *
+ * The results are then checked and merged in order: the walk of each range
+ * must end exactly where the next one started (and, for pcapng, in the
+ * section the next one assumed: the one of the first frames of the file).
+ * Should a range have started on a false boundary (e.g. a packet carrying a
+ * capture file), its tables are dropped and the range is walked again from
+ * the end of the previous one, so that the results are always the ones of a
+ * sequential walk.
+ *
+ * The traffic is reported per address and per OUI (the key of the latter is
+ * the address with a zero 24 bits extension id, e.g. 00:08:AB:00:00:00).
+ * Frames of non Ethernet links and frames shorter than the two addresses are
+ * skipped; a truncated or corrupted file is analyzed up to the last valid
+ * record.
+ *
+ *   MACAddressCapture capture;
+ *   if (capture.open("trace.pcapng") && capture.analyze())
+ *     capture.addresses().forEach([](MAC48 mac, const MACAddressTraffic &t) {
+ *       ...
+ *     });
+ */
+class MACAddressCapture {
+public:
+  enum class Format { NONE, PCAP, PCAPNG };
+
+  MACAddressCapture(void) {}
+  ~MACAddressCapture(void) { close(); }
+
+  MACAddressCapture(const MACAddressCapture &) = delete;
+  MACAddressCapture &operator=(const MACAddressCapture &) = delete;
+
+  // Maps a capture file, false if it cannot be read or is not a capture
+  bool open(const char *path);
+  void close(void);
+  Format format(void) const { return _format; }
+
+  /*
+   * Analyzes the capture with the given number of threads (0: one per
+   * hardware thread), replacing the results of any previous analysis.
+   * @return: the number of Ethernet frames counted.
+   */
+  uint64_t analyze(unsigned threads = 0);
+
+  const MACAddressMap<MACAddressTraffic> &addresses(void) const {
+    return _addresses;
+  }
+  const MACAddressMap<MACAddressTraffic> &ouis(void) const { return _ouis; }
+
+  uint64_t frames(void) const { return _frames; }
+  uint64_t bytes(void) const { return _bytes; }
+  uint64_t skipped(void) const { return _skipped; }
+
+private:
+  // Ranges of bytes smaller than this are not worth a thread
+  static const size_t _min_range{1 << 20};
+  // Headers checked to recognize the first record of a range
+  static const uint8_t _sync_records{8};
+
+  // pcapng section: byte order and link type of its interfaces
+  struct Section {
+    bool swap{false};
+    std::vector<uint16_t> links;
+
+    bool operator==(const Section &section) const {
+      return swap == section.swap && links == section.links;
+    }
+  };
+
+  // Results of the walk of a range
+  struct Partial {
+    MACAddressMap<MACAddressTraffic> addresses;
+    MACAddressMap<MACAddressTraffic> ouis;
+    uint64_t frames{0};
+    uint64_t bytes{0};
+    uint64_t skipped{0};
+
+    size_t end{0};  // where the walk stopped
+    Section first;  // pcapng: section assumed at the start
+    Section last;   // pcapng: section at the end
+  };
+
+  const uint8_t *_map{nullptr};
+  size_t _length{0};
+  Format _format{Format::NONE};
+  bool _swap{false};  // pcap: file byte order differs from the host one
+  bool _nano{false};  // pcap: nanosecond timestamps
+  uint32_t _link{0};  // pcap: link type
+  uint32_t _snaplen{0};
+  size_t _first{0}; // first record (pcap) or block (pcapng)
+
+  MACAddressMap<MACAddressTraffic> _addresses;
+  MACAddressMap<MACAddressTraffic> _ouis;
+  uint64_t _frames{0};
+  uint64_t _bytes{0};
+  uint64_t _skipped{0};
+
+  uint32_t _read32(size_t offset, bool swap) const;
+  uint16_t _read16(size_t offset, bool swap) const;
+
+  size_t _block(size_t pos, bool swap) const;
+  bool _plausible(size_t pos, const Section &section) const;
+  size_t _sync(size_t pos, const Section &section) const;
+  size_t _walk(size_t pos, size_t limit, Section &section,
+               Partial &partial) const;
+  static void _count(const uint8_t frame[], size_t captured, uint32_t length,
+                     Partial &partial);
+  static void _merge(MACAddressMap<MACAddressTraffic> &to,
+                     const MACAddressMap<MACAddressTraffic> &from);
+};
+
+#endif // MACADDRESS_HAS_MMAP && MACADDRESS_HAS_THREAD
+
+#endif // _MACAddressCapture_h_
@@ -0,0 +1,102 @@
+/*
+ *      @file: MACAddressClassifier.cpp
+ */
+
+#include "MACAddressClassifier.h"
+
+#include <new>
+
+#include "MACAddressBatch.h"
+
+// Lookups issued ahead of the one being done (see _classify())
+static const size_t _prefetch_distance{8};
+
+uint32_t MACAddressClassifier::add(const MACAddressPrefix &prefix) {
+  const uint64_t mask = prefix.mask().value();
+
+  uint8_t g{0};
+  while (g != _groups && _group[g].mask != mask)
+    ++g;
+  if (g == _groups) {
+    if (_groups == max_masks)
+      return none;
+    MACADDRESS_STATS_ALLOCATION();
+    // nothrow: a board out of memory gets nullptr, not a crash
+    MACAddressMap<uint32_t> *rules =
+        new (std::nothrow) MACAddressMap<uint32_t>;
+    if (rules == nullptr)
+      return none;
+    _group[g].mask = mask;
+    _group[g].first = _rules;
+    _group[g].rules = rules;
+    ++_groups;
+  }
+
+  // an earlier rule with the same value and mask wins
+  MACAddressMap<uint32_t> &rules = *_group[g].rules;
+  if (rules.find(prefix.value()) == nullptr) {
+    // most addresses match no rule of a group: at most 3/8 full, the probes
+    // of their lookups reach a free slot sooner
+    rules.reserve(2 * (rules.size() + 1));
+    rules.insert(prefix.value(), _rules);
+  }
+
+  return _rules++;
+}
+
+void MACAddressClassifier::clear(void) {
+  for (uint8_t g = 0; g != _groups; ++g) {
+    delete _group[g].rules;
+    _group[g] = Group{};
+  }
+  _groups = 0;
+  _rules = 0;
+}
+
+uint32_t MACAddressClassifier::classify(MAC48 mac) const {
+  uint32_t rc{none};
+  for (uint8_t g = 0; g != _groups && _group[g].first < rc; ++g) {
+    const uint32_t *rule =
+        _group[g].rules->find(MAC48{mac.value() & _group[g].mask});
+    if (rule != nullptr && *rule < rc)
+      rc = *rule;
+  }
+  return rc;
+}
+
+template <typename Read>
+void MACAddressClassifier::_classify(Read read, size_t count,
+                                     uint32_t rules[]) const {
+  for (size_t i = 0; i != count; ++i)
+    rules[i] = none;
+
+  for (uint8_t g = 0; g != _groups; ++g) {
+    const Group &group = _group[g];
+    for (size_t i = 0; i != count; ++i) {
+      if (i + _prefetch_distance < count)
+        group.rules->prefetch(
+            MAC48{read(i + _prefetch_distance).value() & group.mask});
+
+      if (group.first < rules[i]) {
+        const uint32_t *rule =
+            group.rules->find(MAC48{read(i).value() & group.mask});
+        if (rule != nullptr && *rule < rules[i])
+          rules[i] = *rule;
+      }
+    }
+  }
+}
+
+void MACAddressClassifier::classify(const MAC48 macs[], size_t count,
+                                    uint32_t rules[]) const {
+  _classify([macs](size_t i) { return macs[i]; }, count, rules);
+}
+
+void MACAddressClassifier::classify(const uint8_t octets[], size_t count,
+                                    uint32_t rules[]) const {
+  _classify(
+      [octets](size_t i) {
+        return MAC48::fromOctets(octets + MACAddressBatch::octets_size * i);
+      },
+      count, rules);
+}
@@ -0,0 +1,91 @@
+#ifndef _MACAddressClassifier_h_
+#define _MACAddressClassifier_h_
+
+/*
+ *      @file: MACAddressClassifier.h
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+#include "MACAddressMap.h"
+#include "MACAddressPrefix.h"
+
+// Maximum number of distinct masks among the rules of a MACAddressClassifier
+#ifndef MACADDRESS_CLASSIFIER_MASKS
+#if defined(__AVR__)
+#define MACADDRESS_CLASSIFIER_MASKS 4
+#else
+#define MACADDRESS_CLASSIFIER_MASKS 16
+#endif
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressClassifier class finds the first of a list of rules (see
+ * MACAddressPrefix) matching an address, e.g. the entries of an ACL:
+ *
+ *   MACAddressClassifier acl;
+ *   acl.add(MACAddressPrefix{"00:1A:2B:00:00:00"_mac, 24}); // rule 0
+ *   acl.add(MACAddressPrefix::local());                     // rule 1
+ *   ...
+ *   uint32_t rule = acl.classify(mac); // MACAddressClassifier::none if no
+ *                                      // rule matches
+ *
+ * Thousands of rules share a few distinct masks (24, 28 and 36 bits blocks,
+ * the I/G and U/L bits...): the rules are grouped by mask, and each group is
+ * a hash table (see MACAddressMap) from the masked values to the first rule
+ * holding them. Classifying an address takes one lookup per distinct mask,
+ * whatever the number of rules; the groups are visited in the order of their
+ * first rule, so the lookups stop as soon as no later group can hold an
+ * earlier rule than the one found.
+ *
+ * The batch overloads classify arrays of addresses one group at a time,
+ * prefetching the slots of the next addresses so that the lookups of a
+ * large rule set overlap their cache misses.
+ */
+class MACAddressClassifier {
+public:
+  static const uint32_t none{0xFFFFFFFF};
+  static const uint8_t max_masks{MACADDRESS_CLASSIFIER_MASKS};
+
+  MACAddressClassifier(void) {}
+  ~MACAddressClassifier(void) { clear(); }
+
+  MACAddressClassifier(const MACAddressClassifier &) = delete;
+  MACAddressClassifier &operator=(const MACAddressClassifier &) = delete;
+
+  /*
+   * Appends a rule (rules are numbered from 0 in the order they are added).
+   * @return: the rule number, none if its mask would be one more than
+   *          max_masks or its group cannot be allocated.
+   */
+  uint32_t add(const MACAddressPrefix &prefix);
+  void clear(void);
+
+  size_t size(void) const { return _rules; }
+  uint8_t masks(void) const { return _groups; }
+
+  // Number of the first rule matching mac, none if no rule matches
+  uint32_t classify(MAC48 mac) const;
+
+  // Classifies count addresses into rules
+  void classify(const MAC48 macs[], size_t count, uint32_t rules[]) const;
+  void classify(const uint8_t octets[], size_t count, uint32_t rules[]) const;
+
+private:
+  // Rules sharing a mask
+  struct Group {
+    uint64_t mask{0};
+    uint32_t first{0};                       // first rule of the group
+    MACAddressMap<uint32_t> *rules{nullptr}; // masked value -> first rule
+  };
+
+  Group _group[max_masks];
+  uint8_t _groups{0};
+  uint32_t _rules{0};
+
+  template <typename Read>
+  void _classify(Read read, size_t count, uint32_t rules[]) const;
+};
+
+#endif // _MACAddressClassifier_h_
@@ -0,0 +1,103 @@
+/*
+ *      @file: MACAddressDerivation.cpp
+ */
+
+#include "MACAddressDerivation.h"
+
+#include "MACAddressBatch.h"
+
+static const uint64_t _ipv4_count{0x100000000ull}; // 2^32
+// Lookups issued ahead of the one being checked (see collisions())
+static const size_t _prefetch_distance{8};
+
+// Reads a dotted decimal IPv4 address, advancing p past it
+static bool _parseIPv4(const char *&p, uint32_t &ip) {
+  ip = 0;
+  for (uint8_t i = 0; i != 4; ++i) {
+    if (i != 0 && *p++ != '.')
+      return false;
+
+    uint16_t octet{0};
+    uint8_t digits{0};
+    for (; *p >= '0' && *p <= '9' && digits != 4; ++p, ++digits)
+      octet = static_cast<uint16_t>(octet * 10 + (*p - '0'));
+    if (digits == 0 || digits == 4 || octet > 255)
+      return false;
+
+    ip = ip << 8 | octet;
+  }
+  return true;
+}
+
+bool MACAddressDerivation::parseRange(const char text[], uint32_t &first,
+                                      uint64_t &count) {
+  const char *p = text;
+  uint32_t ip;
+  if (!_parseIPv4(p, ip))
+    return false;
+
+  if (*p == '/') {
+    uint8_t length{0}, digits{0};
+    for (++p; *p >= '0' && *p <= '9' && digits != 3; ++p, ++digits)
+      length = static_cast<uint8_t>(length * 10 + (*p - '0'));
+    if (digits == 0 || digits == 3 || length > 32 || *p != '\0')
+      return false;
+
+    count = _ipv4_count >> length;
+    first = ip & static_cast<uint32_t>(~(count - 1));
+    return true;
+  }
+
+  uint32_t last{ip};
+  if (*p == '-' && (!_parseIPv4(++p, last) || last < ip))
+    return false;
+  if (*p != '\0')
+    return false;
+
+  first = ip;
+  count = static_cast<uint64_t>(last - ip) + 1;
+  return true;
+}
+
+bool MACAddressDerivation::fits(MAC48 base, MA ma, Rule rule, uint32_t first,
+                                uint64_t count) {
+  if (count > _ipv4_count - first)
+    return false;
+
+  return rule == Rule::EMBED || count == 0 ||
+         base.getExtensionId(ma) + (count - 1) <= MAC48::extensionIdMask(ma);
+}
+
+size_t MACAddressDerivation::derive(MAC48 base, MA ma, Rule rule,
+                                    uint32_t first, size_t count,
+                                    uint8_t octets[]) {
+  if (count == 0 || !fits(base, ma, rule, first, count))
+    return 0;
+
+  MACAddressBatch::pack(octets, count, _start(base, rule, first));
+  return count;
+}
+
+size_t MACAddressDerivation::collisions(
+    const uint8_t octets[], size_t count,
+    const MACAddressHashTable<MACAddressSetSlot> &existing, uint8_t found[]) {
+  if (found != nullptr)
+    memset(found, 0, (count + 7) / 8);
+
+  // The lookups of a large set miss the caches: their slots are fetched a
+  // few addresses ahead
+  size_t n{0};
+  for (size_t i = 0; i != count; ++i) {
+    if (i + _prefetch_distance < count)
+      existing.prefetch(MAC48::fromOctets(
+          octets + MACAddressBatch::octets_size * (i + _prefetch_distance)));
+
+    if (existing.contains(
+            MAC48::fromOctets(octets + MACAddressBatch::octets_size * i))) {
+      ++n;
+      if (found != nullptr)
+        found[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+    }
+  }
+  return n;
+}
@@ -0,0 +1,118 @@
+#ifndef _MACAddressDerivation_h_
+#define _MACAddressDerivation_h_
+
+/*
+ *      @file: MACAddressDerivation.h
+ *
+ * Addresses derived from IPv4 addresses, a whole subnet at a time.
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+#include "MACAddressMap.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressDerivation class derives the addresses of the hosts of an
+ * IPv4 range (a CIDR block such as 10.1.0.0/16, or first-last) from a base
+ * address, following one of two rules:
+ *   - EMBED: the four octets of the IPv4 address replace the last four octets
+ *     of the base address (mac[2 + i] = ip[i], whatever the MA block size):
+ *     192.168.1.234 gives xx:xx:C0:A8:01:EA;
+ *   - OFFSET: the extension id of the base address, in its MA-L, MA-M or
+ *     MA-S block, is increased by the offset of the IPv4 address within the
+ *     range, so that the range takes consecutive ids of the block.
+ *
+ * IPv4 addresses are 32 bits integers holding the first octet in their most
+ * significant bits (192.168.1.234 == 0xC0A801EA, see ipv4()).
+ *
+ * Under both rules consecutive IPv4 addresses give consecutive 48 bits
+ * values, so the packed arrays are filled by a loop of additions and
+ * unaligned 8 bytes stores, without any MACAddress object.
+ *
+ *   uint32_t first;
+ *   uint64_t count;
+ *   MACAddressDerivation::parseRange("10.1.0.0/16", first, count);
+ *   MACAddressDerivation::derive("00:08:AB:00:00:00"_mac, MA::L,
+ *                                MACAddressDerivation::Rule::OFFSET, first,
+ *                                count, octets);
+ */
+class MACAddressDerivation {
+public:
+  enum class Rule { EMBED, OFFSET };
+
+  static constexpr uint32_t ipv4(uint8_t first, uint8_t second, uint8_t third,
+                                 uint8_t fourth) {
+    return static_cast<uint32_t>(first) << 24 |
+           static_cast<uint32_t>(second) << 16 |
+           static_cast<uint32_t>(third) << 8 | fourth;
+  }
+
+  /*
+   * Parses an IPv4 range: a CIDR block ("10.1.0.0/16", its host bits are
+   * ignored), an inclusive range ("10.1.0.10-10.1.0.99") or a single address.
+   * @return: false if text is not a range.
+   */
+  static bool parseRange(const char text[], uint32_t &first, uint64_t &count);
+
+  /*
+   * True if the count IPv4 addresses from first on can be derived from base:
+   * they do not go past 255.255.255.255 and, for OFFSET, their extension ids
+   * do not overflow the MA block of base.
+   */
+  static bool fits(MAC48 base, MA ma, Rule rule, uint32_t first,
+                   uint64_t count);
+
+  // Address of ip, within a range starting at first which fits (the MA block
+  // size only matters to fits())
+  static MAC48 derive(MAC48 base, Rule rule, uint32_t first, uint32_t ip) {
+    return MAC48{_start(base, rule, first) + (ip - first)};
+  }
+
+  /*
+   * Writes the addresses of the count IPv4 addresses from first on into the
+   * packed array octets (6 * count bytes, see MACAddressBatch).
+   * @return: count, or 0 if the range does not fit (see fits()), in which case
+   *          nothing is written.
+   */
+  static size_t derive(MAC48 base, MA ma, Rule rule, uint32_t first,
+                       size_t count, uint8_t octets[]);
+
+  /*
+   * Calls f(uint32_t ip, MAC48 mac) for the addresses of the range, in
+   * order, until it returns false.
+   * @return: the number of calls (0 if the range does not fit).
+   */
+  template <typename F>
+  static uint64_t forEach(MAC48 base, MA ma, Rule rule, uint32_t first,
+                          uint64_t count, F f) {
+    if (!fits(base, ma, rule, first, count))
+      return 0;
+
+    const uint64_t start = _start(base, rule, first);
+    for (uint64_t i = 0; i != count; ++i)
+      if (!f(static_cast<uint32_t>(first + i), MAC48{start + i}))
+        return i + 1;
+    return count;
+  }
+
+  /*
+   * Looks the count packed addresses up in existing (a MACAddressSet or a
+   * MACAddressFixedSet) and marks the ones found in the bitmap found, if not
+   * nullptr (bit i % 8 of found[i / 8], as MACAddressBatch::parse() does).
+   * @return: the number of addresses found.
+   */
+  static size_t collisions(
+      const uint8_t octets[], size_t count,
+      const MACAddressHashTable<MACAddressSetSlot> &existing,
+      uint8_t found[] = nullptr);
+
+private:
+  // Value of the address of first: the following ones are increments of it
+  static uint64_t _start(MAC48 base, Rule rule, uint32_t first) {
+    return rule == Rule::EMBED ? (base.value() & ~0xFFFFFFFFull) | first
+                               : base.value();
+  }
+};
+
+#endif // _MACAddressDerivation_h_
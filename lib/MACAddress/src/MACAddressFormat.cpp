@@ -0,0 +1,101 @@
+/*
+ *      @file: MACAddressFormat.cpp
+ */
+
+#include "MACAddressFormat.h"
+
+#include "MACAddressStats.h"
+
+const char MACAddressFormat::hex[]{'0', '1', '2', '3', '4', '5', '6', '7',
+                                   '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+// The two hexadecimal digits of every octet value ("00" ... "FF"), kept in
+// flash on the boards
+#define MACADDRESS_PAIRS(h)                                                    \
+  h "0" h "1" h "2" h "3" h "4" h "5" h "6" h "7"                              \
+  h "8" h "9" h "A" h "B" h "C" h "D" h "E" h "F"
+static const char _pairs[] PROGMEM =
+    MACADDRESS_PAIRS("0") MACADDRESS_PAIRS("1") MACADDRESS_PAIRS("2")
+    MACADDRESS_PAIRS("3") MACADDRESS_PAIRS("4") MACADDRESS_PAIRS("5")
+    MACADDRESS_PAIRS("6") MACADDRESS_PAIRS("7") MACADDRESS_PAIRS("8")
+    MACADDRESS_PAIRS("9") MACADDRESS_PAIRS("A") MACADDRESS_PAIRS("B")
+    MACADDRESS_PAIRS("C") MACADDRESS_PAIRS("D") MACADDRESS_PAIRS("E")
+    MACADDRESS_PAIRS("F");
+#undef MACADDRESS_PAIRS
+
+static_assert(sizeof(_pairs) == 2 * 256 + 1, "one pair per octet value");
+
+char *MACAddressFormat::write(char *out, const uint8_t octets[],
+                              Representation representation) {
+  MACADDRESS_STATS_SCOPE(FORMAT);
+
+  if (representation != Representation::COMMON_COMPACT) {
+    const char separator =
+        representation == Representation::EUI48 ? '-' : ':';
+    for (uint8_t i = 0; i != 6; ++i) {
+      const char *pair = _pairs + 2 * octets[i];
+      *out++ = static_cast<char>(pgm_read_byte(pair));
+      *out++ = static_cast<char>(pgm_read_byte(pair + 1));
+      if (i != 5)
+        *out++ = separator;
+    }
+    return out;
+  }
+
+  /*
+   * Both digits of a compact octet are written, starting from the second one
+   * below 0x10, and the output advances by the digits kept (2, 1 or none for
+   * a zeroed octet): no octet value takes a branch. The character dropped
+   * is overwritten by the separator, but a zeroed octet also leaves a digit
+   * after it, which the next octet overwrites unless it is a zeroed last
+   * octet: the characters past the end returned are scratch, written within
+   * the MACAddressFormat::size characters of the full representation (the
+   * output never advances faster than it).
+   */
+  for (uint8_t i = 0; i != 5; ++i) {
+    const uint8_t octet = octets[i];
+    const char *pair = _pairs + 2 * octet;
+    out[0] = static_cast<char>(pgm_read_byte(pair + (octet < 0x10)));
+    out[1] = static_cast<char>(pgm_read_byte(pair + 1));
+    out += (octet != 0) + (octet > 0x0F);
+    *out++ = ':';
+  }
+
+  const uint8_t octet = octets[5];
+  const char *pair = _pairs + 2 * octet;
+  if (octet > 0x0F)
+    *out++ = static_cast<char>(pgm_read_byte(pair));
+  if (octet != 0)
+    *out++ = static_cast<char>(pgm_read_byte(pair + 1));
+  return out;
+}
+
+size_t MACAddressFormat::print(Print &p, const uint8_t octets[],
+                               Representation representation) {
+  char buffer[size];
+  const char *end = write(buffer, octets, representation);
+  return p.write(reinterpret_cast<const uint8_t *>(buffer), end - buffer);
+}
+
+char *MACAddressFormat::hexToChars(char *first, char *last, uint64_t n) {
+  uint8_t digits{1};
+  while (digits != 16 && (n >> (4 * digits)) != 0)
+    ++digits;
+  if (last - first < digits)
+    return nullptr;
+
+  char *end = first + digits;
+  for (char *p = end; p != first; n >>= 4)
+    *--p = hex[n & 0x0F];
+  return end;
+}
+
+MACAddressText::MACAddressText(const uint8_t octets[],
+                               Representation representation)
+    : _representation{representation} {
+  memcpy(_octets, octets, sizeof(_octets));
+}
+
+size_t MACAddressText::printTo(Print &p) const {
+  return MACAddressFormat::print(p, _octets, _representation);
+}
@@ -0,0 +1,67 @@
+#ifndef _MACAddressFormat_h_
+#define _MACAddressFormat_h_
+
+/*
+ *      @file: MACAddressFormat.h
+ *
+ * Scalar formatting core shared by every textual output of the library.
+ */
+
+#include <Arduino.h>
+
+enum class Representation { EUI48, COMMON_FULL, COMMON_COMPACT };
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressFormat class writes the six octets of an address in one of the
+ * three representations:
+ *   - COMMON_FULL:    AB:CD:EF:01:02:00
+ *   - EUI48:          AB-CD-EF-01-02-00
+ *   - COMMON_COMPACT: AB:CD:EF:1:2:    (leading zeros and zeroed octets
+ *                                       stripped)
+ * into a caller supplied buffer, without any terminator.
+ */
+class MACAddressFormat {
+public:
+  // Maximum number of characters written (the NUL terminator excluded)
+  static const uint8_t size{17};
+
+  static const char hex[];
+
+  // Writes the address and returns the end of the written characters; out
+  // must hold size characters, as COMMON_COMPACT may leave scratch ones past
+  // the end returned
+  static char *write(char *out, const uint8_t octets[],
+                     Representation representation);
+
+  // Prints the address with a single write to p
+  static size_t print(Print &p, const uint8_t octets[],
+                      Representation representation);
+
+  /*
+   * Writes n in upper case hexadecimal, without leading zeros (e.g. an
+   * extension id) into [first, last), without any terminator.
+   * @return: the end of the written characters, nullptr if the buffer is too
+   *          small (in which case nothing is written).
+   */
+  static char *hexToChars(char *first, char *last, uint64_t n);
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressText class is a Printable holding a copy of an address and the
+ * representation to print it in, as returned by MACAddress::as() and
+ * MAC48::as():
+ *
+ *   Serial.println(mac.as(Representation::EUI48));
+ */
+class MACAddressText : public Printable {
+public:
+  MACAddressText(const uint8_t octets[], Representation representation);
+
+  virtual size_t printTo(Print &p) const;
+
+private:
+  uint8_t _octets[6];
+  Representation _representation;
+};
+
+#endif // _MACAddressFormat_h_
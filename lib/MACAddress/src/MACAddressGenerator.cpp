@@ -0,0 +1,125 @@
+/*
+ *      @file: MACAddressGenerator.cpp
+ */
+
+#include "MACAddressGenerator.h"
+
+/*
+ * Layout of a slot (little endian):
+ *
+ *   sequence (4) | block (6) | MA set (1) | committed end (5) | CRC (2)
+ *
+ * block is the first address of the block of the base address, the
+ * committed end an extension id (up to 2^36, the end of an MA-S block); the
+ * CRC-16/CCITT covers the previous bytes.
+ */
+static const uint8_t _crc_offset{MACAddressGenerator::slot_size - 2};
+
+static uint16_t _crc16(const uint8_t data[], size_t length) {
+  uint16_t crc{0xFFFF};
+  for (size_t i = 0; i != length; ++i) {
+    crc ^= static_cast<uint16_t>(data[i]) << 8;
+    for (uint8_t bit = 0; bit != 8; ++bit)
+      crc = crc & 0x8000 ? static_cast<uint16_t>(crc << 1 ^ 0x1021)
+                         : static_cast<uint16_t>(crc << 1);
+  }
+  return crc;
+}
+
+static void _put(uint8_t *out, uint64_t n, uint8_t bytes) {
+  for (uint8_t i = 0; i != bytes; ++i, n >>= 8)
+    out[i] = static_cast<uint8_t>(n);
+}
+
+static uint64_t _get(const uint8_t *in, uint8_t bytes) {
+  uint64_t n{0};
+  for (uint8_t i = bytes; i != 0; --i)
+    n = n << 8 | in[i - 1];
+  return n;
+}
+
+MACAddressGenerator::MACAddressGenerator(MACAddressStorage &storage,
+                                         MAC48 base, MA ma, uint32_t reserve)
+    : _storage{storage}, _base{base}, _ma{ma},
+      _reserve{reserve != 0 ? reserve : 1}, _next{base.getExtensionId(ma)},
+      _limit{_next} {}
+
+bool MACAddressGenerator::begin(void) {
+  _begun = false;
+  _slots = _storage.size() / slot_size;
+  if (_slots == 0)
+    return false;
+
+  // the first commit lands on slot 0 unless a valid slot is found
+  _slot = _slots - 1;
+  _sequence = 0;
+  _commits = 0;
+  _next = _limit = _base.getExtensionId(_ma);
+
+  const uint64_t block = _base.withExtensionId(_ma, 0).value();
+  bool found{false};
+  for (size_t s = 0; s != _slots; ++s) {
+    uint8_t slot[slot_size];
+    if (!_storage.read(s * slot_size, slot, slot_size))
+      return false;
+
+    const uint32_t sequence = static_cast<uint32_t>(_get(slot, 4));
+    if (_get(slot + _crc_offset, 2) != _crc16(slot, _crc_offset) ||
+        _get(slot + 4, 6) != block || slot[10] != static_cast<uint8_t>(_ma) ||
+        (found && sequence <= _sequence))
+      continue;
+
+    found = true;
+    _sequence = sequence;
+    _slot = s;
+    const uint64_t limit = _get(slot + 11, 5);
+    // never behind the base address
+    _next = _limit = limit > _base.getExtensionId(_ma)
+                         ? limit
+                         : _base.getExtensionId(_ma);
+  }
+  _begun = true;
+  return true;
+}
+
+bool MACAddressGenerator::_commit(uint64_t limit) {
+  const size_t s = _slot + 1 == _slots ? 0 : _slot + 1;
+  uint8_t slot[slot_size];
+  _put(slot, _sequence + 1, 4);
+  _put(slot + 4, _base.withExtensionId(_ma, 0).value(), 6);
+  slot[10] = static_cast<uint8_t>(_ma);
+  _put(slot + 11, limit, 5);
+  _put(slot + _crc_offset, _crc16(slot, _crc_offset), 2);
+  if (!_storage.write(s * slot_size, slot, slot_size))
+    return false;
+
+  ++_sequence;
+  ++_commits;
+  _slot = s;
+  _limit = limit;
+  return true;
+}
+
+bool MACAddressGenerator::next(MAC48 &mac) {
+  const uint64_t end = MAC48::extensionIdMask(_ma) + 1;
+  if (!_begun || _next == end)
+    return false;
+
+  if (_next == _limit) {
+    const uint64_t limit = end - _next > _reserve ? _next + _reserve : end;
+    if (!_commit(limit))
+      return false;
+  }
+
+  mac = _base.withExtensionId(_ma, _next++);
+  return true;
+}
+
+bool MACAddressGenerator::next(MACAddress &mac) {
+  MAC48 value;
+  if (!next(value))
+    return false;
+  mac = MACAddress{value};
+  mac.ma = _ma;
+  return true;
+}
@@ -0,0 +1,93 @@
+#ifndef _MACAddressGenerator_h_
+#define _MACAddressGenerator_h_
+
+/*
+ *      @file: MACAddressGenerator.h
+ */
+
+#include <Arduino.h>
+
+#include "MACAddress.h"
+#include "MACAddressStorage.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressGenerator class hands out the consecutive addresses of a
+ * block (the extension ids of base in the ma set, from the one of base on)
+ * and keeps track of them in a MACAddressStorage, so that a board never
+ * reissues an address after a reboot.
+ *
+ *   MACAddressEEPROMStorage storage{0, 256};
+ *   MACAddressGenerator generator{storage, "0:8:ab:0:0:0"_mac, MA::L};
+ *   generator.begin();
+ *   ...
+ *   MACAddress mac;
+ *   if (generator.next(mac))
+ *     ...
+ *
+ * The storage is not written for every address: the generator reserves a
+ * range of addresses ahead (the reserve argument) and commits the end of the
+ * range only when it is reached. After a reboot the generator starts from the
+ * last end committed: the addresses reserved and not issued are skipped,
+ * never reissued.
+ *
+ * The commits rotate over a ring of slots (as many as fit in the storage),
+ * each one holding a sequence number and a CRC: every write lands on the
+ * slot after the last one, so the wear is spread over the whole storage, and
+ * a write interrupted by a reset leaves the previous slot valid. begin()
+ * recovers the valid slot with the highest sequence number.
+ *
+ * Unlike the MACAddress arithmetic (which wraps around within the block) the
+ * generator stops at the end of the block. Slots written for another base or
+ * MA set are ignored.
+ */
+class MACAddressGenerator {
+public:
+  // Bytes taken by a slot in the storage
+  static const uint8_t slot_size{18};
+
+  MACAddressGenerator(MACAddressStorage &storage, MAC48 base, MA ma,
+                      uint32_t reserve = 256);
+
+  /*
+   * Recovers the state committed to the storage (none on the first boot: the
+   * generator starts from base). The ring is laid out over the storage size
+   * read here, so the storage may be opened after the generator is built.
+   * @return: false if the storage cannot be read or is smaller than a slot.
+   */
+  bool begin(void);
+
+  /*
+   * Hands out the next address, committing a new range first when needed.
+   * @return: false if begin() has not succeeded, the block is exhausted or
+   *          the commit failed (in which case no address is handed out).
+   */
+  bool next(MAC48 &mac);
+  bool next(MACAddress &mac);
+
+  // Next extension id to hand out and end of the range committed
+  uint64_t position(void) const { return _next; }
+  uint64_t committed(void) const { return _limit; }
+
+  // Number of slots of the ring (0 until begin()) and commits made since
+  // begin()
+  size_t slots(void) const { return _slots; }
+  unsigned long commits(void) const { return _commits; }
+
+private:
+  MACAddressStorage &_storage;
+  const MAC48 _base;
+  const MA _ma;
+  const uint32_t _reserve;
+  size_t _slots{0};
+  bool _begun{false};
+
+  uint64_t _next;
+  uint64_t _limit;
+  uint32_t _sequence{0};
+  size_t _slot{0}; // last slot written (or recovered)
+  unsigned long _commits{0};
+
+  bool _commit(uint64_t limit);
+};
+
+#endif // _MACAddressGenerator_h_
@@ -0,0 +1,363 @@
+#ifndef _MACAddressMap_h_
+#define _MACAddressMap_h_
+
+/*
+ *      @file: MACAddressMap.h
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+#include "MACAddressStats.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Flat open addressing hash maps and sets keyed by 48 bits addresses:
+ *   - MACAddressMap<V> and MACAddressSet grow on the heap as needed;
+ *   - MACAddressFixedMap<V, N> and MACAddressFixedSet<N> hold N slots inline
+ *     (N a power of two) and never touch the heap, so they fit a Mega as
+ *     well as a global or stack object.
+ *
+ * Keys are MAC48 values stored inline in the slots (no per-node allocation),
+ * next to their value for maps; a slot is free when its key is not a 48 bits
+ * value, so no extra state is needed. Collisions are resolved by linear
+ * probing and erasures by backward shifting (no tombstones), which keeps the
+ * probe sequences short and the lookups within one or two cache lines.
+ *
+ * The slot of a key is picked by a multiplicative (Fibonacci) hash, which
+ * spreads well the sequential extension ids of a block; on 8 bits boards the
+ * key is folded and hashed on 32 bits.
+ *
+ * Values must be default constructible and copyable; references and pointers
+ * to them are invalidated by insertions (maps may grow) and erasures.
+ */
+template <typename Slot> class MACAddressHashTable {
+protected:
+  static const uint64_t _free{~0ull};
+
+  Slot *_slots{nullptr};
+  size_t _mask{0}; // capacity - 1
+  size_t _size{0};
+  uint8_t _shift{0};
+
+  // The home slot is made of the top bits of the hash: the hash is narrowed
+  // to size_t (16 bits on AVR) only after the shift
+#if __SIZEOF_SIZE_T__ == 8
+  static uint64_t _hash(uint64_t key) { return key * 0x9E3779B97F4A7C15ull; }
+  static const uint8_t _hash_bits{64};
+#else
+  static uint32_t _hash(uint64_t key) {
+    return static_cast<uint32_t>(key ^ (key >> 24)) * 0x9E3779B1ul;
+  }
+  static const uint8_t _hash_bits{32};
+#endif
+
+  size_t _home(uint64_t key) const {
+    return static_cast<size_t>(_hash(key) >> _shift);
+  }
+
+  void _attach(Slot *slots, size_t capacity) {
+    _slots = slots;
+    _mask = capacity - 1;
+    _shift = _hash_bits;
+    while (capacity > 1) {
+      capacity >>= 1;
+      --_shift;
+    }
+    for (size_t i = 0; i <= _mask; ++i)
+      _slots[i].key = _free;
+  }
+
+  Slot *_find(uint64_t key) const {
+    for (size_t i = _home(key);; i = (i + 1) & _mask) {
+      if (_slots[i].key == key)
+        return &_slots[i];
+      if (_slots[i].key == _free)
+        return nullptr;
+    }
+  }
+
+  // The table must have a free slot
+  Slot *_insert(uint64_t key, bool &inserted) {
+    for (size_t i = _home(key);; i = (i + 1) & _mask) {
+      if (_slots[i].key == key) {
+        inserted = false;
+        return &_slots[i];
+      }
+      if (_slots[i].key == _free) {
+        _slots[i].key = key;
+        ++_size;
+        inserted = true;
+        return &_slots[i];
+      }
+    }
+  }
+
+  bool _erase(uint64_t key) {
+    Slot *slot = _find(key);
+    if (slot == nullptr)
+      return false;
+
+    // backward shift: move back the following entries which are not at their
+    // home slot, so that no probe sequence is broken
+    size_t hole = static_cast<size_t>(slot - _slots);
+    for (size_t i = (hole + 1) & _mask; _slots[i].key != _free;
+         i = (i + 1) & _mask) {
+      const size_t home = _home(_slots[i].key);
+      // can the entry at i move to hole (is hole within [home, i] circularly)?
+      if (((i - home) & _mask) >= ((i - hole) & _mask)) {
+        _slots[hole] = _slots[i];
+        hole = i;
+      }
+    }
+    _slots[hole].key = _free;
+    --_size;
+
+    return true;
+  }
+
+  void _clear(void) {
+    for (size_t i = 0; i <= _mask; ++i)
+      _slots[i].key = _free;
+    _size = 0;
+  }
+
+public:
+  size_t size(void) const { return _size; }
+  bool empty(void) const { return 0 == _size; }
+
+  // Number of slots (the maximum load is 3/4 of it)
+  size_t slots(void) const { return _mask + 1; }
+
+  bool contains(MAC48 key) const { return _find(key.value()) != nullptr; }
+  bool erase(MAC48 key) { return _erase(key.value()); }
+  void clear(void) { _clear(); }
+
+  // Prefetches the slot of key (e.g. a few iterations before a lookup)
+  void prefetch(MAC48 key) const {
+#ifdef __GNUC__
+    __builtin_prefetch(&_slots[_home(key.value())]);
+#else
+    (void)key;
+#endif
+  }
+};
+
+template <typename V> struct MACAddressMapSlot {
+  uint64_t key;
+  V value;
+};
+
+struct MACAddressSetSlot {
+  uint64_t key;
+};
+
+// Map and set operations shared by the fixed and the growing containers
+template <typename V, typename Derived>
+class MACAddressMapBase : public MACAddressHashTable<MACAddressMapSlot<V>> {
+public:
+  V *find(MAC48 key) {
+    MACAddressMapSlot<V> *slot = this->_find(key.value());
+    return slot ? &slot->value : nullptr;
+  }
+  const V *find(MAC48 key) const {
+    const MACAddressMapSlot<V> *slot = this->_find(key.value());
+    return slot ? &slot->value : nullptr;
+  }
+
+  /*
+   * Returns the value of key, inserting a default constructed one if needed.
+   * @return: nullptr only if the key is missing and the map cannot grow.
+   */
+  V *emplace(MAC48 key) {
+    if (!static_cast<Derived *>(this)->_reserveOne())
+      return find(key);
+    bool inserted;
+    MACAddressMapSlot<V> *slot = this->_insert(key.value(), inserted);
+    if (inserted)
+      slot->value = V();
+    return &slot->value;
+  }
+
+  // Inserts or replaces the value of key, false if the map is full
+  bool insert(MAC48 key, const V &value) {
+    V *p = emplace(key);
+    if (p)
+      *p = value;
+    return p != nullptr;
+  }
+
+  // Calls f(MAC48 key, V &value) for every entry, in no particular order
+  template <typename F> void forEach(F f) {
+    for (size_t i = 0; i <= this->_mask; ++i)
+      if (this->_slots[i].key != this->_free)
+        f(MAC48{this->_slots[i].key}, this->_slots[i].value);
+  }
+  template <typename F> void forEach(F f) const {
+    for (size_t i = 0; i <= this->_mask; ++i)
+      if (this->_slots[i].key != this->_free)
+        f(MAC48{this->_slots[i].key},
+          static_cast<const V &>(this->_slots[i].value));
+  }
+};
+
+template <typename Derived>
+class MACAddressSetBase : public MACAddressHashTable<MACAddressSetSlot> {
+public:
+  // Inserts key, false if the set is full
+  bool insert(MAC48 key) {
+    if (!static_cast<Derived *>(this)->_reserveOne())
+      return contains(key);
+    bool inserted;
+    _insert(key.value(), inserted);
+    return true;
+  }
+
+  // Calls f(MAC48 key) for every key, in no particular order
+  template <typename F> void forEach(F f) const {
+    for (size_t i = 0; i <= _mask; ++i)
+      if (_slots[i].key != _free)
+        f(MAC48{_slots[i].key});
+  }
+};
+
+// Fixed capacity storage: N slots inline, no heap
+template <typename Base, typename Slot, size_t N> class MACAddressFixedTable
+    : public Base {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+private:
+  Slot _storage[N];
+
+  // Called by the map and set operations of Base
+  friend Base;
+  bool _reserveOne(void) { return this->_size < capacity(); }
+
+public:
+  MACAddressFixedTable(void) { this->_attach(_storage, N); }
+
+  MACAddressFixedTable(const MACAddressFixedTable &table) : Base{} {
+    this->_attach(_storage, N);
+    for (size_t i = 0; i != N; ++i)
+      _storage[i] = table._storage[i];
+    this->_size = table._size;
+  }
+
+  MACAddressFixedTable &operator=(const MACAddressFixedTable &table) {
+    for (size_t i = 0; i != N; ++i)
+      _storage[i] = table._storage[i];
+    this->_size = table._size;
+    return *this;
+  }
+
+  // Maximum number of entries (3/4 of the slots)
+  static constexpr size_t capacity(void) { return N - N / 4; }
+};
+
+// Growing storage: the number of slots doubles at 3/4 load
+template <typename Base, typename Slot> class MACAddressGrowingTable
+    : public Base {
+private:
+  static const size_t _min_slots{16};
+
+  void _rehash(size_t capacity) {
+    Slot *old = this->_slots;
+    const size_t count = old ? this->_mask + 1 : 0;
+
+    MACADDRESS_STATS_ALLOCATION();
+    this->_attach(new Slot[capacity], capacity);
+    this->_size = 0;
+
+    bool inserted;
+    for (size_t i = 0; i != count; ++i)
+      if (old[i].key != this->_free)
+        *this->_insert(old[i].key, inserted) = old[i];
+
+    delete[] old;
+  }
+
+  // Called by the map and set operations of Base
+  friend Base;
+  bool _reserveOne(void) {
+    reserve(this->_size + 1);
+    return true;
+  }
+
+public:
+  explicit MACAddressGrowingTable(size_t expected = 0) {
+    size_t capacity = _min_slots;
+    while (capacity - capacity / 4 < expected)
+      capacity <<= 1;
+    MACADDRESS_STATS_ALLOCATION();
+    this->_attach(new Slot[capacity], capacity);
+  }
+
+  MACAddressGrowingTable(const MACAddressGrowingTable &table) : Base{} {
+    MACADDRESS_STATS_ALLOCATION();
+    this->_attach(new Slot[table._mask + 1], table._mask + 1);
+    for (size_t i = 0; i <= table._mask; ++i)
+      this->_slots[i] = table._slots[i];
+    this->_size = table._size;
+  }
+
+  MACAddressGrowingTable &operator=(const MACAddressGrowingTable &table) {
+    if (this != &table) {
+      delete[] this->_slots;
+      MACADDRESS_STATS_ALLOCATION();
+      this->_attach(new Slot[table._mask + 1], table._mask + 1);
+      for (size_t i = 0; i <= table._mask; ++i)
+        this->_slots[i] = table._slots[i];
+      this->_size = table._size;
+    }
+    return *this;
+  }
+
+  ~MACAddressGrowingTable(void) { delete[] this->_slots; }
+
+  // Number of entries held before the next growth
+  size_t capacity(void) const {
+    return this->_mask + 1 - (this->_mask + 1) / 4;
+  }
+
+  // Makes room for n entries without further rehashing
+  void reserve(size_t n) {
+    size_t capacity = this->_mask + 1;
+    while (capacity - capacity / 4 < n)
+      capacity <<= 1;
+    if (capacity != this->_mask + 1)
+      _rehash(capacity);
+  }
+};
+
+template <typename V>
+class MACAddressMap
+    : public MACAddressGrowingTable<MACAddressMapBase<V, MACAddressMap<V>>,
+                                    MACAddressMapSlot<V>> {
+public:
+  explicit MACAddressMap(size_t expected = 0)
+      : MACAddressGrowingTable<MACAddressMapBase<V, MACAddressMap<V>>,
+                               MACAddressMapSlot<V>>{expected} {}
+
+  V &operator[](MAC48 key) { return *this->emplace(key); }
+};
+
+template <typename V, size_t N>
+class MACAddressFixedMap
+    : public MACAddressFixedTable<
+          MACAddressMapBase<V, MACAddressFixedMap<V, N>>, MACAddressMapSlot<V>,
+          N> {};
+
+class MACAddressSet
+    : public MACAddressGrowingTable<MACAddressSetBase<MACAddressSet>,
+                                    MACAddressSetSlot> {
+public:
+  explicit MACAddressSet(size_t expected = 0)
+      : MACAddressGrowingTable<MACAddressSetBase<MACAddressSet>,
+                               MACAddressSetSlot>{expected} {}
+};
+
+template <size_t N>
+class MACAddressFixedSet
+    : public MACAddressFixedTable<MACAddressSetBase<MACAddressFixedSet<N>>,
+                                  MACAddressSetSlot, N> {};
+
+#endif // _MACAddressMap_h_
@@ -0,0 +1,49 @@
+/*
+ *      @file: MACAddressParser.cpp
+ */
+
+#include "MACAddressParser.h"
+
+#include "MACAddressStats.h"
+
+MACAddressParser::Status MACAddressParser::parse(const char address[],
+                                                 uint8_t octets[]) {
+  MACADDRESS_STATS_SCOPE(PARSE);
+  RamSource source{address};
+  OctetWriter sink{octets};
+  Status rc = scanAll(source, sink);
+  MACADDRESS_STATS_FAILURE(rc);
+  return rc;
+}
+
+MACAddressParser::Status MACAddressParser::parse_P(PGM_P address,
+                                                   uint8_t octets[]) {
+  MACADDRESS_STATS_SCOPE(PARSE);
+  FlashSource source{address};
+  OctetWriter sink{octets};
+  Status rc = scanAll(source, sink);
+  MACADDRESS_STATS_FAILURE(rc);
+  return rc;
+}
+
+size_t MACAddressParser::parse(const char buffer[], size_t length,
+                               uint8_t octets[], Notation *notation) {
+  MACADDRESS_STATS_SCOPE(PARSE);
+  uint8_t address[6];
+  Notation found{Notation::NONE};
+  SliceSource source{buffer, buffer + length};
+  OctetWriter sink{address};
+
+  size_t rc{0};
+  Status status = scanAny(source, sink, found);
+  MACADDRESS_STATS_FAILURE(status);
+  if (Status::OK == status) {
+    memcpy(octets, address, sizeof(address));
+    rc = static_cast<size_t>(source.p - buffer);
+  }
+
+  if (notation)
+    *notation = found;
+
+  return rc;
+}
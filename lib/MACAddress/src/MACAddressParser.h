@@ -0,0 +1,250 @@
+#ifndef _MACAddressParser_h_
+#define _MACAddressParser_h_
+
+/*
+ *      @file: MACAddressParser.h
+ *
+ * Single pass scanner of the textual MAC address grammar.
+ */
+
+#include <Arduino.h>
+
+// Textual notations recognized by MACAddressParser::parse(buffer, length, ...)
+enum class Notation {
+  NONE,   // not an address
+  COLON,  // AB:CD:EF:01:23:45 (and compact forms such as 8::12:34:56:78)
+  DASH,   // AB-CD-EF-01-23-45 (and compact forms such as 8--12-34-56-78)
+  DOTTED, // abcd.ef01.2345 (Cisco)
+  BARE    // abcdef012345
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressParser class reads an address directly from the caller's
+ * buffer (RAM or flash), one character at a time and without any copy or
+ * heap allocation.
+ *
+ * Accepted addresses are six groups of hexadecimal digits separated by five
+ * colons or by five dashes (the two separators cannot be mixed):
+ *
+ *   AB:CD:EF:01:23:45
+ *   AB-CD-EF-01-23-45
+ *   8::12:34:56:78
+ *   :::::
+ *
+ * An empty group is a zeroed octet; in a group made of more than two digits
+ * the octet is made of the trailing digits after pairing them from the left
+ * ("ABC" == "C", "ABCD" == "CD").
+ *
+ * The scanner is a template over:
+ *   - a Source providing char peek(void) (returning '\0' at the end of the
+ *     input) and void next(void);
+ *   - a Sink called as bool sink(index, octet) for every completed octet and
+ *     returning false to stop the scan (e.g. on the first mismatch while
+ *     comparing).
+ * Both are usually tiny structures the compiler completely inlines.
+ *
+ * Addresses embedded in larger, not NUL terminated buffers (DHCP options, JSON
+ * fields, HTTP bodies...) can be parsed in place by parse(buffer, length, ...)
+ * which also recognizes the Cisco dotted (abcd.ef01.2345) and the bare (12
+ * hexadecimal digits) notations.
+ */
+class MACAddressParser {
+public:
+  enum class Status {
+    OK,
+    BAD_CHAR,            // a character that is not part of the grammar
+    TOO_MANY_SEPARATORS, // more than 5 separators
+    TOO_FEW_SEPARATORS,  // less than 5 separators
+    STOPPED              // the sink asked to stop
+  };
+
+  // Source reading a NUL terminated string stored in RAM
+  struct RamSource {
+    const char *p;
+    char peek(void) const { return *p; }
+    void next(void) { ++p; }
+  };
+
+  // Source reading a NUL terminated string stored in flash (PROGMEM)
+  struct FlashSource {
+    PGM_P p;
+    char peek(void) const { return static_cast<char>(pgm_read_byte(p)); }
+    void next(void) { ++p; }
+  };
+
+  // Source reading at most length characters (a NUL still ends the input)
+  struct SliceSource {
+    const char *p;
+    const char *end;
+    char peek(void) const { return p != end ? *p : '\0'; }
+    void next(void) { ++p; }
+  };
+
+  // Sink storing the octets into an array of (at least) six bytes
+  struct OctetWriter {
+    uint8_t *octets;
+    bool operator()(uint8_t i, uint8_t octet) {
+      octets[i] = octet;
+      return true;
+    }
+  };
+
+  static const uint8_t separators{5};
+
+  // Converts c to its value, returns false if it is not a hexadecimal digit
+  static bool hexToNibble(char c, uint8_t &nibble) {
+    uint8_t d = static_cast<uint8_t>(c - '0');
+    if (d < 10) {
+      nibble = d;
+      return true;
+    }
+    d = static_cast<uint8_t>((c | 0x20) - 'a'); // 0x20: lower case bit
+    if (d < 6) {
+      nibble = d + 10;
+      return true;
+    }
+    return false;
+  }
+
+  /*
+   * Scans an address from source, stopping at the first character which cannot
+   * be part of it: on success the source is left on that character (the end
+   * of the input for a whole string) and every octet has been passed to sink.
+   */
+  template <typename Source, typename Sink>
+  static Status scan(Source &source, Sink &sink) {
+    return _scanGroups(source, sink, 0, true);
+  }
+
+  /*
+   * Same as scan() but also recognizes the dotted and the bare notations,
+   * reporting the one found in notation. The leading digits are read only once:
+   * the first non hexadecimal character decides the notation.
+   */
+  template <typename Source, typename Sink>
+  static Status scanAny(Source &source, Sink &sink, Notation &notation) {
+    uint64_t value{0};
+    uint8_t digits{0}, x{0}, nibble{0};
+    bool first{true};
+
+    notation = Notation::NONE;
+
+    while (hexToNibble(source.peek(), nibble)) {
+      value = (value << 4) | nibble;
+      if (digits != _bareDigits + 1)
+        ++digits;
+      x = first ? nibble : static_cast<uint8_t>((x << 4) + nibble);
+      first = !first;
+      source.next();
+    }
+
+    char c = source.peek();
+    if (c == ':' || c == '-') {
+      Status rc = _scanGroups(source, sink, x, first);
+      if (rc == Status::OK)
+        notation = c == ':' ? Notation::COLON : Notation::DASH;
+      return rc;
+    }
+
+    if (c == '.' && digits == _dottedDigits) {
+      for (uint8_t group = 1; group != 3; ++group) {
+        if (source.peek() != '.')
+          return Status::BAD_CHAR;
+        source.next();
+        for (uint8_t i = 0; i != _dottedDigits; ++i) {
+          if (!hexToNibble(source.peek(), nibble))
+            return Status::BAD_CHAR;
+          value = (value << 4) | nibble;
+          source.next();
+        }
+      }
+      if (hexToNibble(source.peek(), nibble))
+        return Status::BAD_CHAR; // a group longer than 4 digits
+      notation = Notation::DOTTED;
+    } else if (digits == _bareDigits)
+      notation = Notation::BARE;
+    else
+      return (digits > _bareDigits || c == '.') ? Status::BAD_CHAR
+                                                : Status::TOO_FEW_SEPARATORS;
+
+    for (uint8_t i = 0; i != 6; ++i)
+      if (!sink(i, static_cast<uint8_t>(value >> (40 - 8 * i))))
+        return Status::STOPPED;
+
+    return Status::OK;
+  }
+
+  // Scans a whole NUL terminated string: trailing characters are errors
+  template <typename Source, typename Sink>
+  static Status scanAll(Source &source, Sink &sink) {
+    Status rc = scan(source, sink);
+    if (rc == Status::OK) {
+      char c = source.peek();
+      if (c == ':' || c == '-')
+        rc = Status::TOO_MANY_SEPARATORS;
+      else if (c != '\0')
+        rc = Status::BAD_CHAR;
+    }
+    return rc;
+  }
+
+  static Status parse(const char address[], uint8_t octets[]);
+  static Status parse_P(PGM_P address, uint8_t octets[]);
+
+  /*
+   * Parses the address at the beginning of buffer, reading at most length
+   * characters and without requiring any terminator.
+   * Returns the number of characters consumed (0 if there is no valid address,
+   * in which case octets is left untouched) and, if requested, the notation
+   * found. The whole buffer is an address only if the returned value is
+   * equal to length.
+   */
+  static size_t parse(const char buffer[], size_t length, uint8_t octets[],
+                      Notation *notation = nullptr);
+
+private:
+  static const uint8_t _dottedDigits{4};
+  static const uint8_t _bareDigits{12};
+
+  template <typename Source, typename Sink>
+  static Status _scanGroups(Source &source, Sink &sink, uint8_t x,
+                            bool first) {
+    char separator{'\0'};
+    uint8_t n{0}, nibble{0};
+
+    for (;;) {
+      char c = source.peek();
+
+      if (hexToNibble(c, nibble)) {
+        x = first ? nibble : static_cast<uint8_t>((x << 4) + nibble);
+        first = !first;
+      } else if ((c == ':' || c == '-') &&
+                 (separator == '\0' || c == separator)) {
+        if (n == separators)
+          break; // a sixth separator: let the caller decide
+        separator = c;
+        if (!sink(n, x))
+          return Status::STOPPED;
+        ++n;
+        x = 0;
+        first = true;
+      } else
+        break;
+
+      source.next();
+    }
+
+    if (n != separators) {
+      char c = source.peek();
+      return (c == '\0' || c == ':' || c == '-') ? Status::TOO_FEW_SEPARATORS
+                                                 : Status::BAD_CHAR;
+    }
+
+    if (!sink(n, x))
+      return Status::STOPPED;
+
+    return Status::OK;
+  }
+};
+
+#endif // _MACAddressParser_h_
@@ -0,0 +1,54 @@
+/*
+ *      @file: MACAddressPrefix.cpp
+ */
+
+#include "MACAddressPrefix.h"
+
+#include "MACAddressParser.h"
+
+static const uint8_t _max_digits{12};
+
+bool MACAddressPrefix::parse(const char text[], MACAddressPrefix &prefix) {
+  const char *p = text;
+  uint64_t value{0};
+  uint8_t digits{0}, nibble{0};
+
+  // separators only between octets: never first, doubled nor after a half
+  for (;; ++p) {
+    if (MACAddressParser::hexToNibble(*p, nibble)) {
+      if (digits == _max_digits)
+        return false;
+      value = value << 4 | nibble;
+      ++digits;
+    } else if ((*p == ':' || *p == '-') && digits != 0 && !(digits & 1) &&
+               MACAddressParser::hexToNibble(p[1], nibble))
+      continue;
+    else
+      break;
+  }
+  if (digits == 0)
+    return false;
+
+  const MAC48 address{value << (4 * (_max_digits - digits))};
+  if (*p == '\0') {
+    prefix = MACAddressPrefix{address, static_cast<uint8_t>(4 * digits)};
+    return true;
+  }
+  if (*p++ != '/')
+    return false;
+
+  uint8_t mask[6];
+  if (MACAddressParser::Status::OK == MACAddressParser::parse(p, mask)) {
+    prefix = MACAddressPrefix{address, MAC48::fromOctets(mask)};
+    return true;
+  }
+
+  uint8_t length{0}, length_digits{0};
+  for (; *p >= '0' && *p <= '9' && length_digits != 3; ++p, ++length_digits)
+    length = static_cast<uint8_t>(length * 10 + (*p - '0'));
+  if (length_digits == 0 || length_digits == 3 || length > 48 || *p != '\0')
+    return false;
+
+  prefix = MACAddressPrefix{address, length};
+  return true;
+}
@@ -0,0 +1,96 @@
+#ifndef _MACAddressPrefix_h_
+#define _MACAddressPrefix_h_
+
+/*
+ *      @file: MACAddressPrefix.h
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressPrefix class is a set of addresses given by a value and a
+ * mask: an address belongs to it when its bits selected by the mask are the
+ * ones of the value.
+ *
+ * The mask usually selects the leading bits (an OUI, an MA-M or MA-S block:
+ * a prefix of some length), but any mask is accepted, e.g. the U/L bit alone
+ * for every locally administered address:
+ *
+ *   constexpr MACAddressPrefix vendor{"00:1A:2B:00:00:00"_mac, 24};
+ *   constexpr MACAddressPrefix local = MACAddressPrefix::local();
+ *
+ *   MACAddressPrefix block;
+ *   MACAddressPrefix::parse("AB:CD:E/28", block);
+ *   if (block.matches(mac) || local.matches(mac))
+ *     ...
+ *
+ * The bits of the value outside of the mask are always cleared. Many
+ * prefixes are checked at once by MACAddressClassifier.
+ */
+class MACAddressPrefix {
+private:
+  uint64_t _value;
+  uint64_t _mask;
+
+  static constexpr uint64_t _prefixMask(uint8_t length) {
+    return length == 0    ? 0
+           : length >= 48 ? MAC48::mask48
+                          : MAC48::mask48 & ~(MAC48::mask48 >> length);
+  }
+
+public:
+  // Every address
+  constexpr MACAddressPrefix(void) : _value{0}, _mask{0} {}
+
+  // The addresses whose first length bits are the ones of value
+  constexpr MACAddressPrefix(MAC48 value, uint8_t length)
+      : _value{value.value() & _prefixMask(length)},
+        _mask{_prefixMask(length)} {}
+
+  // The addresses whose bits selected by mask are the ones of value
+  constexpr MACAddressPrefix(MAC48 value, MAC48 mask)
+      : _value{value.value() & mask.value()}, _mask{mask.value()} {}
+
+  // The block of the given size (MA-L, MA-M or MA-S) holding address
+  static constexpr MACAddressPrefix block(MAC48 address, MA ma) {
+    return MACAddressPrefix{
+        address, MAC48{MAC48::mask48 & ~MAC48::extensionIdMask(ma)}};
+  }
+
+  // Group (I/G bit set) and locally administered (U/L bit set) addresses
+  static constexpr MACAddressPrefix multicast(void) {
+    return MACAddressPrefix{MAC48{MAC48::ig_bit}, MAC48{MAC48::ig_bit}};
+  }
+  static constexpr MACAddressPrefix local(void) {
+    return MACAddressPrefix{MAC48{MAC48::ul_bit}, MAC48{MAC48::ul_bit}};
+  }
+
+  /*
+   * Parses a prefix written as its leading octets, two hexadecimal digits
+   * each (a trailing single digit is half an octet), separated by colons,
+   * dashes or nothing and optionally followed by
+   *   - "/length": the prefix length in bits ("AB:CD:E0/28");
+   *   - "/mask": a mask written as an address ("02/02:00:00:00:00:00").
+   * Without either, the length is the one of the digits ("AB:CD:E" is /20).
+   * @return: false (leaving prefix untouched) if text is not a prefix.
+   */
+  static bool parse(const char text[], MACAddressPrefix &prefix);
+
+  constexpr MAC48 value(void) const { return MAC48{_value}; }
+  constexpr MAC48 mask(void) const { return MAC48{_mask}; }
+
+  constexpr bool matches(MAC48 mac) const {
+    return (mac.value() & _mask) == _value;
+  }
+
+  constexpr bool operator==(const MACAddressPrefix &prefix) const {
+    return _value == prefix._value && _mask == prefix._mask;
+  }
+  constexpr bool operator!=(const MACAddressPrefix &prefix) const {
+    return !(*this == prefix);
+  }
+};
+
+#endif // _MACAddressPrefix_h_
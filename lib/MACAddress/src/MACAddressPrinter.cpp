@@ -0,0 +1,65 @@
+/*
+ *      @file: MACAddressPrinter.cpp
+ */
+
+#include "MACAddressPrinter.h"
+
+#include "MACAddressBatch.h"
+
+MACAddressPrinter::MACAddressPrinter(Print &p, Representation representation,
+                                     char separator)
+    : _print(p), _representation{representation}, _separator{separator} {}
+
+size_t MACAddressPrinter::print(const MACAddress &mac) {
+  return print(mac.toMAC48());
+}
+
+size_t MACAddressPrinter::print(MAC48 mac) {
+  uint8_t octets[6];
+  mac.toOctets(octets);
+  return print(octets);
+}
+
+size_t MACAddressPrinter::print(const uint8_t octets[]) {
+  if (_capacity - _length < _entry)
+    flush();
+
+  char *end = MACAddressFormat::write(_buffer + _length, octets,
+                                      _representation);
+  *end++ = _separator;
+
+  const size_t n = static_cast<size_t>(end - (_buffer + _length));
+  _length += n;
+  return n;
+}
+
+size_t MACAddressPrinter::print(const uint8_t octets[], size_t count) {
+  size_t n{0};
+  while (count != 0) {
+    size_t room = (_capacity - _length) / _entry;
+    if (room == 0) {
+      flush();
+      room = _capacity / _entry;
+    }
+    if (room > count)
+      room = count;
+
+    const size_t length = MACAddressBatch::format(
+        octets, room, _representation, _buffer + _length, _separator);
+    _length += length;
+    n += length;
+    octets += MACAddressBatch::octets_size * room;
+    count -= room;
+  }
+  return n;
+}
+
+size_t MACAddressPrinter::flush(void) {
+  if (_length == 0)
+    return 0;
+
+  const size_t n =
+      _print.write(reinterpret_cast<const uint8_t *>(_buffer), _length);
+  _length = 0;
+  return n;
+}
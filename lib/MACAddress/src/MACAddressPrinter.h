@@ -0,0 +1,70 @@
+#ifndef _MACAddressPrinter_h_
+#define _MACAddressPrinter_h_
+
+/*
+ *      @file: MACAddressPrinter.h
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+#include "MACAddress.h"
+
+// Size of the buffer of a MACAddressPrinter (at least one address and its
+// separator): three addresses on AVR boards, more elsewhere
+#ifndef MACADDRESS_PRINTER_BUFFER
+#if defined(__AVR__)
+#define MACADDRESS_PRINTER_BUFFER 54
+#else
+#define MACADDRESS_PRINTER_BUFFER 1024
+#endif
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressPrinter class streams many addresses into a Print sink (a
+ * serial port, a network client, ...), each one followed by a separator.
+ *
+ * The text is collected in an internal buffer and handed to the sink with a
+ * single write whenever the buffer is full, on flush() and on destruction;
+ * packed arrays (see MACAddressBatch) are formatted in bulk.
+ *
+ *   MACAddressPrinter printer{Serial, Representation::EUI48};
+ *   for (...)
+ *     printer.print(mac);
+ *   printer.flush();
+ */
+class MACAddressPrinter {
+public:
+  MACAddressPrinter(Print &p,
+                    Representation representation = Representation::COMMON_FULL,
+                    char separator = '\n');
+  ~MACAddressPrinter(void) { flush(); }
+
+  MACAddressPrinter(const MACAddressPrinter &) = delete;
+  MACAddressPrinter &operator=(const MACAddressPrinter &) = delete;
+
+  /*
+   * Appends the address(es) to the buffer.
+   * @return: the number of characters appended.
+   */
+  size_t print(const MACAddress &mac);
+  size_t print(MAC48 mac);
+  size_t print(const uint8_t octets[]);
+  size_t print(const uint8_t octets[], size_t count); // packed
+
+  // Writes the buffered text to the sink, returns the number of bytes written
+  size_t flush(void);
+
+private:
+  static const size_t _capacity{MACADDRESS_PRINTER_BUFFER};
+  static const size_t _entry{MACAddressFormat::size + 1};
+  static_assert(_capacity >= _entry, "MACADDRESS_PRINTER_BUFFER too small");
+
+  Print &_print;
+  Representation _representation;
+  char _separator;
+  size_t _length{0};
+  char _buffer[_capacity];
+};
+
+#endif // _MACAddressPrinter_h_
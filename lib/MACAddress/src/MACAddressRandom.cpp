@@ -0,0 +1,104 @@
+/*
+ *      @file: MACAddressRandom.cpp
+ */
+
+#include "MACAddressRandom.h"
+
+#include "MACAddressBatch.h"
+
+static uint64_t _splitmix64(uint64_t &state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+MACAddressRandom::MACAddressRandom(uint64_t seed) {
+  _setup(seed, MAC48::ul_bit, MAC48::ig_bit | MAC48::ul_bit);
+}
+
+MACAddressRandom::MACAddressRandom(uint64_t seed,
+                                   const MACAddressPrefix &prefix) {
+  const uint64_t mask = prefix.mask().value();
+  _setup(seed,
+         prefix.value().value() | (mask & MAC48::ul_bit ? 0 : MAC48::ul_bit),
+         mask | MAC48::ig_bit | MAC48::ul_bit);
+}
+
+void MACAddressRandom::_setup(uint64_t seed, uint64_t value, uint64_t mask) {
+  _fixed = value & mask;
+
+  // runs of free bits, from the least significant one
+  const uint64_t free = MAC48::mask48 & ~mask;
+  for (uint8_t bit = 0; bit != 48;) {
+    if (!(free >> bit & 1)) {
+      ++bit;
+      continue;
+    }
+
+    uint8_t length{0};
+    while (bit + length != 48 && (free >> (bit + length) & 1))
+      ++length;
+    if (_runs == max_runs) {
+      _runs = 0; // not valid
+      _bits = 48;
+      return;
+    }
+    _run[_runs].mask = ((1ull << length) - 1) << _bits;
+    _run[_runs].shift = static_cast<uint8_t>(bit - _bits);
+    ++_runs;
+    _bits = static_cast<uint8_t>(_bits + length);
+    bit = static_cast<uint8_t>(bit + length);
+  }
+
+  _mask = (1ull << _bits) - 1;
+  _shift[0] = static_cast<uint8_t>(_bits / 2 + 1);
+  _shift[1] = static_cast<uint8_t>(_bits / 3 + 1);
+  for (uint8_t k = 0; k != 6; ++k)
+    _key[k] = _splitmix64(seed);
+  // the multipliers must be odd to be invertible
+  _key[0] |= 1;
+  _key[2] |= 1;
+  _key[4] |= 1;
+}
+
+bool MACAddressRandom::next(MAC48 &mac) {
+  if (remaining() == 0)
+    return false;
+  mac = MAC48{_address(_permute(_count++))};
+  return true;
+}
+
+bool MACAddressRandom::next(MACAddress &mac) {
+  MAC48 value;
+  if (!next(value))
+    return false;
+  mac = MACAddress{value};
+  return true;
+}
+
+size_t MACAddressRandom::generate(MAC48 macs[], size_t count) {
+  if (count > remaining())
+    count = static_cast<size_t>(remaining());
+
+  // a local copy: the stores cannot change the keys, which then stay in
+  // registers
+  const MACAddressRandom random{*this};
+  for (size_t i = 0; i != count; ++i)
+    macs[i] = MAC48{random._address(random._permute(_count + i))};
+  _count += count;
+  return count;
+}
+
+size_t MACAddressRandom::generate(uint8_t octets[], size_t count) {
+  if (count > remaining())
+    count = static_cast<size_t>(remaining());
+
+  const MACAddressRandom random{*this};
+  uint64_t n = _count;
+  MACAddressBatch::pack(octets, count, [&random, &n] {
+    return random._address(random._permute(n++));
+  });
+  _count += count;
+  return count;
+}
@@ -0,0 +1,111 @@
+#ifndef _MACAddressRandom_h_
+#define _MACAddressRandom_h_
+
+/*
+ *      @file: MACAddressRandom.h
+ */
+
+#include <Arduino.h>
+
+#include "MACAddress.h"
+#include "MACAddressPrefix.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressRandom class generates random, unique addresses (e.g. for
+ * test fleets and virtual machines): unicast and locally administered ones,
+ * optionally confined to a MACAddressPrefix (an OUI, a block, any value/mask
+ * pair):
+ *
+ *   MACAddressRandom random{seed};
+ *   random.generate(macs, 1000000);
+ *
+ *   MACAddressRandom vendor{seed, MACAddressPrefix{"0A:1B:2C:0:0:0"_mac, 24}};
+ *   vendor.next(mac);
+ *
+ * The bits fixed by the prefix come from its value; the I/G and U/L bits, if
+ * the prefix does not fix them, are forced to unicast and locally
+ * administered. The other bits (the free ones, 46 without a prefix) hold the
+ * n-th value of a keyed permutation of their 2^bits values, n counting the
+ * addresses generated: no address is repeated until the whole space has been
+ * generated, without any table of the addresses already handed out.
+ *
+ * The permutation is a few rounds of bijective steps modulo 2^bits
+ * (multiplication by odd keys, xorshift, addition of keys), the keys being
+ * drawn from the seed by splitmix64: the same seed gives the same sequence.
+ * The addresses look random but are not meant to be unpredictable.
+ *
+ * The free bits of the prefix must form at most max_runs runs of contiguous
+ * bits (3 for any prefix of leading bits), scattered by a couple of masks and
+ * shifts each.
+ */
+class MACAddressRandom {
+public:
+  static const uint8_t max_runs{3};
+
+  // Unicast, locally administered addresses
+  explicit MACAddressRandom(uint64_t seed);
+
+  // Addresses of prefix (unicast, locally administered unless it says
+  // otherwise)
+  MACAddressRandom(uint64_t seed, const MACAddressPrefix &prefix);
+
+  // False if the free bits of the prefix form more than max_runs runs (in
+  // which case nothing is generated)
+  bool isValid(void) const { return _runs != 0 || _bits == 0; }
+
+  // Number of distinct addresses (2^bits, 0 if not valid) and of the ones
+  // not generated yet
+  uint64_t size(void) const { return isValid() ? _mask + 1 : 0; }
+  uint64_t remaining(void) const { return size() - _count; }
+
+  // The next address, false once every address has been generated
+  bool next(MAC48 &mac);
+  bool next(MACAddress &mac);
+
+  /*
+   * Generates count addresses into macs, or into the packed array octets
+   * (6 * count bytes, see MACAddressBatch).
+   * @return: the number of addresses generated (less than count only when
+   *          the space is exhausted).
+   */
+  size_t generate(MAC48 macs[], size_t count);
+  size_t generate(uint8_t octets[], size_t count);
+
+private:
+  // Free bits of the address fed from a run of the permuted value
+  struct Run {
+    uint64_t mask; // bits of the permuted value
+    uint8_t shift; // to their place in the address
+  };
+
+  uint64_t _fixed{0}; // value of the fixed bits
+  uint64_t _mask{0};  // 2^bits - 1
+  uint8_t _bits{0};
+  uint8_t _runs{0};
+  Run _run[max_runs]{};
+  uint8_t _shift[2]{}; // of the xorshift steps
+  uint64_t _key[6]{};
+  uint64_t _count{0};
+
+  void _setup(uint64_t seed, uint64_t value, uint64_t mask);
+
+  uint64_t _permute(uint64_t n) const {
+    uint64_t x = n;
+    x = (x * _key[0] + _key[1]) & _mask;
+    x ^= x >> _shift[0];
+    x = (x * _key[2] + _key[3]) & _mask;
+    x ^= x >> _shift[1];
+    x = (x * _key[4] + _key[5]) & _mask;
+    x ^= x >> _shift[0];
+    return x;
+  }
+
+  // The unused runs have an empty mask: no branch
+  uint64_t _address(uint64_t x) const {
+    return _fixed | (x & _run[0].mask) << _run[0].shift |
+           (x & _run[1].mask) << _run[1].shift |
+           (x & _run[2].mask) << _run[2].shift;
+  }
+};
+
+#endif // _MACAddressRandom_h_
@@ -0,0 +1,54 @@
+/*
+ *      @file: MACAddressRange.cpp
+ */
+
+#include "MACAddressRange.h"
+
+#include "MACAddressBatch.h"
+
+MACAddressRange::MACAddressRange(MAC48 first, uint64_t count, MA ma) {
+  const uint64_t mask = MAC48::extensionIdMask(ma);
+  const uint64_t id = first.getExtensionId(ma);
+
+  if (count > mask + 1)
+    count = mask + 1;
+  _first = iterator{first.value() & ~mask, mask, id};
+  _last = iterator{first.value() & ~mask, mask, id + count};
+}
+
+MACAddressRange::MACAddressRange(MAC48 first, MAC48 last, MA ma)
+    : MACAddressRange{first,
+                      (last.getExtensionId(ma) - first.getExtensionId(ma)) &
+                          MAC48::extensionIdMask(ma),
+                      ma} {}
+
+bool MACAddressRange::contains(MAC48 mac) const {
+  return (mac.value() & ~_first._mask) == _first._oui &&
+         ((mac.value() - _first._id) & _first._mask) < size();
+}
+
+size_t MACAddressRange::fill(uint8_t octets[]) const {
+  const size_t count = static_cast<size_t>(size());
+
+  // At most two runs of consecutive values: up to the end of the block, then
+  // (wrapping around) from its extension id 0 on
+  uint64_t id = _first._id & _first._mask;
+  for (size_t i = 0; i != count; id = 0) {
+    size_t run = count - i;
+    if (run > _first._mask + 1 - id)
+      run = static_cast<size_t>(_first._mask + 1 - id);
+    MACAddressBatch::pack(octets + MACAddressBatch::octets_size * i, run,
+                          _first._oui | id);
+    i += run;
+  }
+  return count;
+}
+
+size_t MACAddressRange::fill(MAC48 macs[]) const {
+  const size_t count = static_cast<size_t>(size());
+
+  iterator it = _first;
+  for (size_t i = 0; i != count; ++i, ++it)
+    macs[i] = *it;
+  return count;
+}
@@ -0,0 +1,161 @@
+#ifndef _MACAddressRange_h_
+#define _MACAddressRange_h_
+
+/*
+ *      @file: MACAddressRange.h
+ */
+
+#include <Arduino.h>
+
+#if defined(__has_include)
+#if __has_include(<iterator>)
+#define MACADDRESS_HAS_ITERATOR 1
+#include <iterator>
+#endif
+#endif
+
+#include "MAC48.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressRange class is the sequence [first, last) of consecutive
+ * addresses of an MA-L, MA-M or MA-S block, as MACAddress::operator++ would
+ * walk it: the extension id wraps around within the block, the OUI never
+ * changes.
+ *
+ *   for (MAC48 mac : MACAddressRange{"00:08:AB:00:00:10"_mac, 100, MA::L})
+ *     ...
+ *
+ *   MACAddressRange range = MACAddressRange::block(mac, MA::M);
+ *   MAC48 last = range[range.size() - 1];
+ *
+ * The addresses are computed rather than stored: an iterator is the OUI bits,
+ * the mask of the extension id and a counter, dereferenced with an and and an
+ * or. Iterators are random access (begin() + k costs the same as ++), so
+ * that a range can be split among workers or into chunks:
+ *
+ *   MACAddressRange{range.begin() + k, range.begin() + k + n}.fill(octets);
+ *
+ * fill() writes thousands of addresses at once into a packed array (see
+ * MACAddressBatch) or an array of MAC48.
+ */
+class MACAddressRange {
+public:
+  class iterator {
+  public:
+#ifdef MACADDRESS_HAS_ITERATOR
+    typedef std::random_access_iterator_tag iterator_category;
+#endif
+    typedef MAC48 value_type;
+    typedef int64_t difference_type;
+    typedef const MAC48 *pointer;
+    typedef MAC48 reference; // computed, not stored
+
+    iterator(void) {}
+
+    MAC48 operator*(void) const { return MAC48{_oui | (_id & _mask)}; }
+    MAC48 operator[](difference_type k) const { return *(*this + k); }
+
+    iterator &operator++(void) {
+      ++_id;
+      return *this;
+    }
+    iterator &operator--(void) {
+      --_id;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator rc{*this};
+      ++_id;
+      return rc;
+    }
+    iterator operator--(int) {
+      iterator rc{*this};
+      --_id;
+      return rc;
+    }
+
+    iterator &operator+=(difference_type k) {
+      _id += static_cast<uint64_t>(k);
+      return *this;
+    }
+    iterator &operator-=(difference_type k) {
+      _id -= static_cast<uint64_t>(k);
+      return *this;
+    }
+    iterator operator+(difference_type k) const { return iterator{*this} += k; }
+    iterator operator-(difference_type k) const { return iterator{*this} -= k; }
+    friend iterator operator+(difference_type k, const iterator &i) {
+      return i + k;
+    }
+    difference_type operator-(const iterator &i) const {
+      return static_cast<difference_type>(_id - i._id);
+    }
+
+    // Iterators are only compared within the same range
+    bool operator==(const iterator &i) const { return _id == i._id; }
+    bool operator!=(const iterator &i) const { return _id != i._id; }
+    bool operator<(const iterator &i) const { return _id < i._id; }
+    bool operator<=(const iterator &i) const { return _id <= i._id; }
+    bool operator>(const iterator &i) const { return _id > i._id; }
+    bool operator>=(const iterator &i) const { return _id >= i._id; }
+
+  private:
+    friend class MACAddressRange;
+
+    iterator(uint64_t oui, uint64_t mask, uint64_t id)
+        : _oui{oui}, _mask{mask}, _id{id} {}
+
+    uint64_t _oui{0};  // the bits outside the extension id
+    uint64_t _mask{0}; // extension id bits
+    uint64_t _id{0};   // extension id, not wrapped yet
+  };
+
+  typedef iterator const_iterator;
+
+  // An empty range
+  MACAddressRange(void) {}
+
+  // The count addresses from first on (at most the size of its block)
+  MACAddressRange(MAC48 first, uint64_t count, MA ma = MA::L);
+
+  // The addresses from first up to last excluded, last in the block of first
+  // (first == last is an empty range: see block() for a whole one)
+  MACAddressRange(MAC48 first, MAC48 last, MA ma = MA::L);
+
+  // A part of another range
+  MACAddressRange(iterator first, iterator last)
+      : _first{first}, _last{first._id < last._id ? last : first} {}
+
+  // Every address of the block of mac, from extension id 0 on
+  static MACAddressRange block(MAC48 mac, MA ma) {
+    return MACAddressRange{mac.withExtensionId(ma, 0),
+                           MAC48::extensionIdMask(ma) + 1, ma};
+  }
+
+  iterator begin(void) const { return _first; }
+  iterator end(void) const { return _last; }
+
+  uint64_t size(void) const { return _last._id - _first._id; }
+  bool empty(void) const { return _last._id == _first._id; }
+
+  // Address k of the range (k < size())
+  MAC48 operator[](uint64_t k) const {
+    return MAC48{_first._oui | ((_first._id + k) & _first._mask)};
+  }
+
+  bool contains(MAC48 mac) const;
+
+  /*
+   * Writes the addresses of the range into the packed array octets
+   * (6 * size() bytes, see MACAddressBatch) or into macs (size() items).
+   * @return: the number of addresses written.
+   */
+  size_t fill(uint8_t octets[]) const;
+  size_t fill(MAC48 macs[]) const;
+
+private:
+  iterator _first;
+  iterator _last;
+};
+
+#endif // _MACAddressRange_h_
@@ -0,0 +1,349 @@
+/*
+ *      @file: MACAddressRegistry.cpp
+ */
+
+#include "MACAddressRegistry.h"
+
+#ifdef MACADDRESS_HAS_MMAP
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+const uint8_t MACAddressRegistry::_bits[_tables]{24, 28, 36};
+
+/*
+ * Layout of the compiled file (host byte order, checked through _endian):
+ *
+ *   header | keys[0] names[0] | keys[1] names[1] | keys[2] names[2] | pool
+ *
+ * keys[t] are the prefixes (the top _bits[t] bits of the addresses) in
+ * Eytzinger order, names[t] the matching 1-based offsets into the pool of NUL
+ * terminated names (0: no name), the top bit flagging the MA-L entries with
+ * longer assignments below them.
+ */
+static const char _magic[8]{'M', 'A', 'C', 'O', 'U', 'I', '\0', '\1'};
+static const uint32_t _endian{0x01020304};
+static const uint32_t _nested{0x80000000};
+
+struct MACAddressRegistryHeader {
+  char magic[8];
+  uint32_t endian;
+  uint32_t count[3];
+  uint64_t keys[3];
+  uint64_t names[3];
+  uint64_t pool;
+  uint64_t pool_size;
+};
+
+typedef std::map<uint64_t, uint32_t> MACAddressRegistryTable;
+
+// Next CSV field of text starting at pos (RFC 4180 quoting), false at the end
+// of the text; last is set on the final field of a record.
+static bool _field(const std::string &text, size_t &pos,
+                   std::string &field, bool &last) {
+  field.clear();
+  if (pos >= text.size())
+    return false;
+
+  if (text[pos] == '"') {
+    for (++pos; pos < text.size(); ++pos) {
+      if (text[pos] == '"') {
+        if (pos + 1 < text.size() && text[pos + 1] == '"')
+          field += text[++pos];
+        else {
+          ++pos;
+          break;
+        }
+      } else
+        field += text[pos];
+    }
+  }
+  while (pos < text.size() && text[pos] != ',' && text[pos] != '\n')
+    field += text[pos++];
+
+  last = pos >= text.size() || text[pos] == '\n';
+  ++pos;
+
+  // trim (also the \r of the CRLF line ends)
+  size_t begin = field.find_first_not_of(" \t\r");
+  size_t end = field.find_last_not_of(" \t\r");
+  field = begin == std::string::npos ? std::string{}
+                                     : field.substr(begin, end - begin + 1);
+  return true;
+}
+
+// Assignment (hex digits, possibly with separators) to prefix and table.
+static bool _assignment(const std::string &field, uint64_t &prefix,
+                        uint8_t &table) {
+  uint8_t digits{0};
+  prefix = 0;
+  for (size_t i = 0; i != field.size(); ++i) {
+    const char c = field[i];
+    if (c == ':' || c == '-' || c == '.')
+      continue;
+
+    uint8_t nibble{0};
+    if (c >= '0' && c <= '9')
+      nibble = c - '0';
+    else if (c >= 'A' && c <= 'F')
+      nibble = c - 'A' + 10;
+    else if (c >= 'a' && c <= 'f')
+      nibble = c - 'a' + 10;
+    else
+      return false;
+
+    prefix = (prefix << 4) | nibble;
+    ++digits;
+  }
+
+  switch (digits) {
+  case 6:
+    table = 0;
+    return true;
+  case 7:
+    table = 1;
+    return true;
+  case 9:
+    table = 2;
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool _load(const char *path, std::string &text) {
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    return false;
+
+  char buffer[65536];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) != 0)
+    text.append(buffer, n);
+
+  const bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+// In-order walk of the implicit tree rooted at k filling it with sorted.
+static void _eytzinger(const std::vector<uint64_t> &sorted, size_t &i,
+                       size_t k, std::vector<uint64_t> &out) {
+  if (k >= out.size())
+    return;
+  _eytzinger(sorted, i, 2 * k + 1, out);
+  out[k] = sorted[i++];
+  _eytzinger(sorted, i, 2 * k + 2, out);
+}
+
+size_t MACAddressRegistry::compile(const char *const csvs[], size_t count,
+                                   const char *output) {
+  MACAddressRegistryTable tables[_tables];
+  std::map<std::string, uint32_t> names;
+  std::string pool;
+
+  for (size_t c = 0; c != count; ++c) {
+    std::string text;
+    if (!_load(csvs[c], text))
+      return 0;
+
+    size_t pos{0};
+    std::string field;
+    while (pos < text.size()) {
+      // Registry, Assignment, Organization Name, ...
+      std::string record[3];
+      bool last{false};
+      for (uint8_t f = 0; !last && _field(text, pos, field, last); ++f)
+        if (f < 3)
+          record[f] = field;
+
+      uint64_t prefix;
+      uint8_t table;
+      if (!_assignment(record[1], prefix, table))
+        continue; // header, blank line or unknown assignment
+
+      auto name = names.find(record[2]);
+      if (name == names.end()) {
+        name = names.emplace(record[2], pool.size() + 1).first;
+        pool.append(record[2]).push_back('\0');
+      }
+      tables[table].emplace(prefix, name->second);
+    }
+  }
+
+  // flag (or add) the MA-L entries with longer assignments below them
+  for (uint8_t t = 1; t != _tables; ++t)
+    for (const auto &entry : tables[t])
+      tables[0][entry.first >> (_bits[t] - _bits[0])] |= _nested;
+
+  MACAddressRegistryHeader header{};
+  memcpy(header.magic, _magic, sizeof(_magic));
+  header.endian = _endian;
+
+  std::vector<uint64_t> keys[_tables];
+  std::vector<uint32_t> offsets[_tables];
+  uint64_t at{sizeof(MACAddressRegistryHeader)};
+  size_t assignments{0};
+  for (uint8_t t = 0; t != _tables; ++t) {
+    std::vector<uint64_t> sorted;
+    for (const auto &entry : tables[t]) {
+      sorted.push_back(entry.first);
+      if (entry.second & ~_nested)
+        ++assignments;
+    }
+
+    size_t i{0};
+    keys[t].resize(sorted.size());
+    _eytzinger(sorted, i, 0, keys[t]);
+    for (uint64_t key : keys[t])
+      offsets[t].push_back(tables[t][key]);
+
+    header.count[t] = static_cast<uint32_t>(sorted.size());
+    header.keys[t] = at;
+    at += sorted.size() * sizeof(uint64_t);
+    header.names[t] = at;
+    at += (sorted.size() * sizeof(uint32_t) + 7) & ~7ull;
+  }
+  header.pool = at;
+  header.pool_size = pool.size();
+
+  FILE *file = fopen(output, "wb");
+  if (file == nullptr)
+    return 0;
+
+  bool ok = 1 == fwrite(&header, sizeof(header), 1, file);
+  const uint32_t padding{0};
+  for (uint8_t t = 0; t != _tables; ++t) {
+    ok = ok && keys[t].size() == fwrite(keys[t].data(), sizeof(uint64_t),
+                                        keys[t].size(), file);
+    ok = ok && offsets[t].size() == fwrite(offsets[t].data(),
+                                           sizeof(uint32_t),
+                                           offsets[t].size(), file);
+    if (offsets[t].size() & 1)
+      ok = ok && 1 == fwrite(&padding, sizeof(padding), 1, file);
+  }
+  ok = ok && pool.size() == fwrite(pool.data(), 1, pool.size(), file);
+  ok = (0 == fclose(file)) && ok;
+
+  return ok ? assignments : 0;
+}
+
+bool MACAddressRegistry::open(const char *path) {
+  close();
+
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  void *map{MAP_FAILED};
+  if (0 == fstat(fd, &st) &&
+      st.st_size >= static_cast<off_t>(sizeof(MACAddressRegistryHeader)))
+    map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  _map = map;
+  _length = st.st_size;
+
+  // never trust the file: everything must be within the mapping
+  const MACAddressRegistryHeader &header =
+      *static_cast<const MACAddressRegistryHeader *>(map);
+  const char *base = static_cast<const char *>(map);
+  bool ok = 0 == memcmp(header.magic, _magic, sizeof(_magic)) &&
+            header.endian == _endian && header.pool <= _length &&
+            header.pool_size <= _length - header.pool &&
+            (header.pool_size == 0 ||
+             base[header.pool + header.pool_size - 1] == '\0');
+  for (uint8_t t = 0; ok && t != _tables; ++t) {
+    const uint64_t count = header.count[t];
+    ok = 0 == (header.keys[t] & 7) && 0 == (header.names[t] & 3) &&
+         header.keys[t] <= _length &&
+         count * sizeof(uint64_t) <= _length - header.keys[t] &&
+         header.names[t] <= _length &&
+         count * sizeof(uint32_t) <= _length - header.names[t];
+    if (ok) {
+      _keys[t] = reinterpret_cast<const uint64_t *>(base + header.keys[t]);
+      _names[t] = reinterpret_cast<const uint32_t *>(base + header.names[t]);
+      _count[t] = header.count[t];
+    }
+  }
+  if (!ok) {
+    close();
+    return false;
+  }
+
+  _pool = base + header.pool;
+  _pool_size = header.pool_size;
+  return true;
+}
+
+void MACAddressRegistry::close(void) {
+  if (_map != nullptr)
+    munmap(_map, _length);
+
+  _map = nullptr;
+  _length = 0;
+  for (uint8_t t = 0; t != _tables; ++t) {
+    _keys[t] = nullptr;
+    _names[t] = nullptr;
+    _count[t] = 0;
+  }
+  _pool = nullptr;
+  _pool_size = 0;
+}
+
+size_t MACAddressRegistry::_search(const uint64_t *keys, size_t count,
+                                   uint64_t key) {
+  // Eytzinger descent: the comparison picks the child, the only branch
+  // being the exit on a match
+  size_t k{0};
+  while (k < count) {
+    const uint64_t node = keys[k];
+    if (node == key)
+      return k;
+    k = 2 * k + 1 + (node < key);
+  }
+  return count;
+}
+
+const char *MACAddressRegistry::_name(uint32_t offset) const {
+  offset &= ~_nested;
+  return offset == 0 || offset > _pool_size ? nullptr : _pool + offset - 1;
+}
+
+const char *MACAddressRegistry::lookup(MAC48 mac, uint8_t *bits) const {
+  const uint64_t value = mac.value();
+
+  size_t k = _search(_keys[0], _count[0], value >> (48 - _bits[0]));
+  if (k == _count[0])
+    return nullptr;
+
+  const uint32_t oui = _names[0][k];
+  if (oui & _nested) {
+    for (uint8_t t = _tables - 1; t != 0; --t) {
+      k = _search(_keys[t], _count[t], value >> (48 - _bits[t]));
+      if (k != _count[t]) {
+        if (bits != nullptr)
+          *bits = _bits[t];
+        return _name(_names[t][k]);
+      }
+    }
+  }
+
+  const char *name = _name(oui);
+  if (name != nullptr && bits != nullptr)
+    *bits = _bits[0];
+  return name;
+}
+
+#endif // MACADDRESS_HAS_MMAP
@@ -0,0 +1,90 @@
+#ifndef _MACAddressRegistry_h_
+#define _MACAddressRegistry_h_
+
+/*
+ *      @file: MACAddressRegistry.h
+ *
+ * Only available on POSIX hosts (it memory maps files): not on the boards.
+ */
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define MACADDRESS_HAS_MMAP 1
+#endif
+
+#ifdef MACADDRESS_HAS_MMAP
+
+#include "MAC48.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressRegistry class resolves addresses to the organization they
+ * have been assigned to by the IEEE Registration Authority.
+ *
+ * The public registry CSV files (oui.csv, mam.csv, oui36.csv, iab.csv:
+ * "Registry,Assignment,Organization Name,Organization Address") are compiled
+ * once by compile() (see also the macaddress_ouicompile tool) into a compact
+ * binary file, which open() memory maps as is: nothing is parsed at load time.
+ *
+ * The file holds three tables of assignments (24 bits MA-L, 28 bits MA-M, 36
+ * bits MA-S/IAB prefixes) stored in Eytzinger order (the implicit layout of a
+ * binary search tree: the first levels visited by every search share a few
+ * cache lines), a parallel array of name offsets and the pool of the names.
+ * The MA-L entries are flagged when longer assignments exist below them (an
+ * entry without a name is added when needed), so that most lookups end after
+ * a single search; flagged ones also search the 36 and 28 bits tables, the
+ * longest match winning.
+ *
+ * Note: these are the IEEE prefix lengths, unrelated to the MA set of a
+ * MACAddress (which selects the length of the extension id used by the
+ * arithmetic operators).
+ */
+class MACAddressRegistry {
+public:
+  MACAddressRegistry(void) {}
+  ~MACAddressRegistry(void) { close(); }
+
+  MACAddressRegistry(const MACAddressRegistry &) = delete;
+  MACAddressRegistry &operator=(const MACAddressRegistry &) = delete;
+
+  /*
+   * Compiles the registry CSV files csvs into the binary file output.
+   * @return: the number of assignments written, 0 on failure (unreadable
+   *          input or unwritable output).
+   */
+  static size_t compile(const char *const csvs[], size_t count,
+                        const char *output);
+
+  // Maps a compiled registry, false if it cannot be read or is not valid
+  bool open(const char *path);
+  void close(void);
+  bool isOpen(void) const { return _map != nullptr; }
+
+  /*
+   * Returns the organization the (longest) assignment including mac belongs
+   * to, nullptr if there is none; bits (if requested) receives the length of
+   * the prefix matched: 24, 28 or 36.
+   */
+  const char *lookup(MAC48 mac, uint8_t *bits = nullptr) const;
+
+  // Number of assignments in the 24, 28 and 36 bits tables
+  size_t size(void) const { return _count[0] + _count[1] + _count[2]; }
+
+private:
+  static const uint8_t _tables{3};
+  static const uint8_t _bits[_tables];
+
+  void *_map{nullptr};
+  size_t _length{0};
+
+  const uint64_t *_keys[_tables]{nullptr, nullptr, nullptr};
+  const uint32_t *_names[_tables]{nullptr, nullptr, nullptr};
+  uint32_t _count[_tables]{0, 0, 0};
+  const char *_pool{nullptr};
+  uint64_t _pool_size{0};
+
+  static size_t _search(const uint64_t *keys, size_t count, uint64_t key);
+  const char *_name(uint32_t offset) const;
+};
+
+#endif // MACADDRESS_HAS_MMAP
+
+#endif // _MACAddressRegistry_h_
@@ -0,0 +1,388 @@
+/*
+ *      @file: MACAddressSort.cpp
+ */
+
+#include "MACAddressSort.h"
+
+#include "MACAddressBatch.h"
+
+#ifdef MACADDRESS_HAS_THREAD
+#include <atomic>
+#include <thread>
+#include <vector>
+#endif
+
+static const uint8_t _positions{6}; // bytes of an address
+static const uint16_t _radix{256};
+
+// Access to the addresses of a MAC48 array...
+struct MACAddressSortValues {
+  typedef MAC48 Item;
+
+  static uint64_t key(const MAC48 *p, size_t i) { return p[i].value(); }
+  static uint8_t digit(const MAC48 *p, size_t i, uint8_t position) {
+    return static_cast<uint8_t>(p[i].value() >> (8 * position));
+  }
+  static MAC48 *at(MAC48 *p, size_t i) { return p + i; }
+  static void copy(MAC48 *to, size_t j, const MAC48 *from, size_t i) {
+    to[j] = from[i];
+  }
+  static void move(MAC48 *to, size_t j, const MAC48 *from, size_t i) {
+    to[j] = from[i];
+  }
+  static size_t bytes(size_t count) { return count * sizeof(MAC48); }
+};
+
+// ... and of a packed one
+struct MACAddressSortPacked {
+  typedef uint8_t Item;
+  static const uint8_t size{MACAddressBatch::octets_size};
+
+  static uint64_t key(const uint8_t *p, size_t i) {
+    p += size * i;
+    return static_cast<uint64_t>(p[0]) << 40 |
+           static_cast<uint64_t>(p[1]) << 32 |
+           static_cast<uint64_t>(p[2]) << 24 |
+           static_cast<uint64_t>(p[3]) << 16 |
+           static_cast<uint64_t>(p[4]) << 8 | p[5];
+  }
+  static uint8_t digit(const uint8_t *p, size_t i, uint8_t position) {
+    return p[size * i + 5 - position];
+  }
+  static uint8_t *at(uint8_t *p, size_t i) { return p + size * i; }
+  static void copy(uint8_t *to, size_t j, const uint8_t *from, size_t i) {
+    memcpy(to + size * j, from + size * i, size);
+  }
+  static void move(uint8_t *to, size_t j, const uint8_t *from, size_t i) {
+    memmove(to + size * j, from + size * i, size);
+  }
+  static size_t bytes(size_t count) { return count * size; }
+};
+
+// Counts the byte values at the first positions of the addresses
+template <typename R>
+static void _count(const typename R::Item *p, size_t begin, size_t end,
+                   size_t counts[], uint8_t positions) {
+  for (size_t i = begin; i != end; ++i) {
+    const uint64_t key = R::key(p, i);
+    for (uint8_t position = 0; position != positions; ++position)
+      ++counts[position * _radix + ((key >> (8 * position)) & 0xFF)];
+  }
+}
+
+// Turns the counts of the byte values into the offsets of their buckets
+static void _offsets(size_t counts[], size_t offset = 0) {
+  for (uint16_t d = 0; d != _radix; ++d) {
+    const size_t n = counts[d];
+    counts[d] = offset;
+    offset += n;
+  }
+}
+
+// Stable scattering of [begin, end) of src by the byte at position
+template <typename R>
+static void _scatter(const typename R::Item *src, size_t begin, size_t end,
+                     typename R::Item *dst, uint8_t position,
+                     size_t offsets[]) {
+  for (size_t i = begin; i != end; ++i)
+    R::copy(dst, offsets[R::digit(src, i, position)]++, src, i);
+}
+
+// True if every address has the same byte at position (nothing to sort)
+template <typename R>
+static bool _constant(const typename R::Item *p, size_t count,
+                      const size_t counts[], uint8_t position) {
+  return counts[position * _radix + R::digit(p, 0, position)] == count;
+}
+
+// LSD sort by the first positions bytes, for arrays fitting in the caches
+template <typename R>
+static void _lsd(typename R::Item *values, size_t count,
+                 typename R::Item *scratch, uint8_t positions) {
+  if (count < 2)
+    return;
+
+  size_t counts[_positions * _radix]{};
+  _count<R>(values, 0, count, counts, positions);
+
+  typename R::Item *src = values, *dst = scratch;
+  for (uint8_t position = 0; position != positions; ++position) {
+    if (_constant<R>(values, count, counts, position))
+      continue;
+
+    _offsets(counts + position * _radix);
+    _scatter<R>(src, 0, count, dst, position, counts + position * _radix);
+
+    typename R::Item *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != values)
+    memcpy(values, src, R::bytes(count));
+}
+
+/*
+ * Large arrays are split first by their most significant byte (MSD), so that
+ * only one or two scattering passes go to memory: the buckets are then small
+ * enough to be sorted within the caches by _lsd(). _msd() sorts values in
+ * place, _msdInto() sorts src into dst; both use the other array as scratch.
+ */
+static const size_t _cached{1 << 14};
+
+template <typename R>
+static void _msdInto(typename R::Item *src, size_t count,
+                     typename R::Item *dst, uint8_t positions);
+
+template <typename R>
+static void _msd(typename R::Item *values, size_t count,
+                 typename R::Item *scratch, uint8_t positions) {
+  if (count <= _cached || positions < 2) {
+    _lsd<R>(values, count, scratch, positions);
+    return;
+  }
+
+  const uint8_t position = positions - 1;
+  size_t offsets[_radix]{};
+  for (size_t i = 0; i != count; ++i)
+    ++offsets[R::digit(values, i, position)];
+  if (offsets[R::digit(values, 0, position)] == count) {
+    _msd<R>(values, count, scratch, position);
+    return;
+  }
+
+  _offsets(offsets);
+  _scatter<R>(values, 0, count, scratch, position, offsets);
+
+  size_t begin{0};
+  for (uint16_t d = 0; d != _radix; begin = offsets[d++])
+    _msdInto<R>(R::at(scratch, begin), offsets[d] - begin,
+                R::at(values, begin), position);
+}
+
+template <typename R>
+static void _msdInto(typename R::Item *src, size_t count,
+                     typename R::Item *dst, uint8_t positions) {
+  if (count <= _cached || positions < 2) {
+    memcpy(dst, src, R::bytes(count));
+    _lsd<R>(dst, count, src, positions);
+    return;
+  }
+
+  const uint8_t position = positions - 1;
+  size_t offsets[_radix]{};
+  for (size_t i = 0; i != count; ++i)
+    ++offsets[R::digit(src, i, position)];
+  if (offsets[R::digit(src, 0, position)] == count) {
+    _msdInto<R>(src, count, dst, position);
+    return;
+  }
+
+  _offsets(offsets);
+  _scatter<R>(src, 0, count, dst, position, offsets);
+
+  size_t begin{0};
+  for (uint16_t d = 0; d != _radix; begin = offsets[d++])
+    _msd<R>(R::at(dst, begin), offsets[d] - begin, R::at(src, begin),
+            position);
+}
+
+/*
+ * On AVR boards the counts of _lsd() alone (3 KB) exceed the RAM of an Uno:
+ * the arrays sorted there are small anyway, and insertion sort needs no
+ * memory but a single address of scratch.
+ */
+template <typename R>
+static void _insertion(typename R::Item *values, size_t count,
+                       typename R::Item *scratch) {
+  for (size_t i = 1; i < count; ++i) {
+    const uint64_t key = R::key(values, i);
+    size_t j = i;
+    if (R::key(values, j - 1) <= key)
+      continue;
+
+    R::copy(scratch, 0, values, i);
+    for (; j != 0 && R::key(values, j - 1) > key; --j)
+      R::move(values, j, values, j - 1);
+    R::copy(values, j, scratch, 0);
+  }
+}
+
+void MACAddressSort::sort(MAC48 values[], size_t count, MAC48 scratch[]) {
+#ifdef __AVR__
+  _insertion<MACAddressSortValues>(values, count, scratch);
+#else
+  _msd<MACAddressSortValues>(values, count, scratch, _positions);
+#endif
+}
+
+void MACAddressSort::sort(uint8_t octets[], size_t count, uint8_t scratch[]) {
+#ifdef __AVR__
+  _insertion<MACAddressSortPacked>(octets, count, scratch);
+#else
+  _msd<MACAddressSortPacked>(octets, count, scratch, _positions);
+#endif
+}
+
+#ifdef MACADDRESS_HAS_THREAD
+
+// Runs f(0) ... f(threads - 1) concurrently
+template <typename F> static void _parallel(unsigned threads, F f) {
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(f, t);
+  f(0);
+  for (std::thread &thread : pool)
+    thread.join();
+}
+
+/*
+ * The threads count the bytes of a chunk of the array each, then scatter it
+ * by the most significant byte which is not the same in every address (each
+ * chunk after the ones of the previous chunks, so that the result is the one
+ * of the sequential pass); the buckets are then sorted independently, taken
+ * in turn by the first idle thread.
+ */
+template <typename R>
+static void _sortParallel(typename R::Item *values, size_t count,
+                          typename R::Item *scratch, unsigned threads) {
+  // below a few pages per thread spawning them costs more than it saves
+  static const size_t chunk{1 << 16};
+
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads > count / chunk)
+    threads = static_cast<unsigned>(count / chunk);
+  if (threads < 2) {
+    _msd<R>(values, count, scratch, _positions);
+    return;
+  }
+
+  const size_t size{_positions * _radix};
+  std::vector<size_t> counts(threads * size);
+  auto begin = [&](unsigned t) { return count * t / threads; };
+
+  _parallel(threads, [&](unsigned t) {
+    _count<R>(values, begin(t), begin(t + 1), &counts[t * size], _positions);
+  });
+
+  size_t total[size]{};
+  for (unsigned t = 0; t != threads; ++t)
+    for (size_t i = 0; i != size; ++i)
+      total[i] += counts[t * size + i];
+
+  uint8_t positions{_positions};
+  while (positions != 0 && _constant<R>(values, count, total, positions - 1))
+    --positions;
+  if (positions == 0)
+    return;
+
+  const uint8_t position = positions - 1;
+  size_t offset{0};
+  for (uint16_t d = 0; d != _radix; ++d) {
+    for (unsigned t = 0; t != threads; ++t) {
+      size_t &n = counts[t * size + position * _radix + d];
+      const size_t c = n;
+      n = offset;
+      offset += c;
+    }
+  }
+
+  _parallel(threads, [&](unsigned t) {
+    _scatter<R>(values, begin(t), begin(t + 1), scratch, position,
+                &counts[t * size + position * _radix]);
+  });
+
+  // after the scattering the last thread offsets are the bucket ends
+  const size_t *ends = &counts[(threads - 1) * size + position * _radix];
+  std::atomic<uint16_t> next{0};
+  _parallel(threads, [&](unsigned) {
+    for (uint16_t d; (d = next++) < _radix;) {
+      const size_t first = d == 0 ? 0 : ends[d - 1];
+      _msdInto<R>(R::at(scratch, first), ends[d] - first,
+                  R::at(values, first), position);
+    }
+  });
+}
+
+void MACAddressSort::sortParallel(MAC48 values[], size_t count,
+                                  MAC48 scratch[], unsigned threads) {
+  _sortParallel<MACAddressSortValues>(values, count, scratch, threads);
+}
+
+void MACAddressSort::sortParallel(uint8_t octets[], size_t count,
+                                  uint8_t scratch[], unsigned threads) {
+  _sortParallel<MACAddressSortPacked>(octets, count, scratch, threads);
+}
+
+#endif // MACADDRESS_HAS_THREAD
+
+template <typename R>
+static size_t _unique(typename R::Item *values, size_t count) {
+  if (count == 0)
+    return 0;
+
+  size_t n{1};
+  uint64_t last = R::key(values, 0);
+  for (size_t i = 1; i != count; ++i) {
+    const uint64_t key = R::key(values, i);
+    if (key != last) {
+      R::move(values, n++, values, i);
+      last = key;
+    }
+  }
+  return n;
+}
+
+size_t MACAddressSort::unique(MAC48 values[], size_t count) {
+  return _unique<MACAddressSortValues>(values, count);
+}
+
+size_t MACAddressSort::unique(uint8_t octets[], size_t count) {
+  return _unique<MACAddressSortPacked>(octets, count);
+}
+
+// Merge of a and b keeping the addresses of a found (or not) in b
+template <typename R>
+static size_t _merge(const typename R::Item *a, size_t count_a,
+                     const typename R::Item *b, size_t count_b,
+                     typename R::Item *out, bool found) {
+  size_t i{0}, j{0}, n{0};
+  while (i != count_a) {
+    const uint64_t key = R::key(a, i);
+    while (j != count_b && R::key(b, j) < key)
+      ++j;
+
+    const bool match = j != count_b && R::key(b, j) == key;
+    if (match == found)
+      R::move(out, n++, a, i);
+    if (match)
+      ++j; // each address of b matches once
+    ++i;
+  }
+  return n;
+}
+
+size_t MACAddressSort::intersection(const MAC48 a[], size_t count_a,
+                                    const MAC48 b[], size_t count_b,
+                                    MAC48 out[]) {
+  return _merge<MACAddressSortValues>(a, count_a, b, count_b, out, true);
+}
+
+size_t MACAddressSort::intersection(const uint8_t a[], size_t count_a,
+                                    const uint8_t b[], size_t count_b,
+                                    uint8_t out[]) {
+  return _merge<MACAddressSortPacked>(a, count_a, b, count_b, out, true);
+}
+
+size_t MACAddressSort::difference(const MAC48 a[], size_t count_a,
+                                  const MAC48 b[], size_t count_b,
+                                  MAC48 out[]) {
+  return _merge<MACAddressSortValues>(a, count_a, b, count_b, out, false);
+}
+
+size_t MACAddressSort::difference(const uint8_t a[], size_t count_a,
+                                  const uint8_t b[], size_t count_b,
+                                  uint8_t out[]) {
+  return _merge<MACAddressSortPacked>(a, count_a, b, count_b, out, false);
+}
@@ -0,0 +1,85 @@
+#ifndef _MACAddressSort_h_
+#define _MACAddressSort_h_
+
+/*
+ *      @file: MACAddressSort.h
+ *
+ * The parallel sort is only available where the toolchain provides <thread>
+ * (hosts, ESP boards): not on AVR boards.
+ */
+
+#if defined(__has_include)
+#if __has_include(<thread>)
+#define MACADDRESS_HAS_THREAD 1
+#endif
+#endif
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressSort class sorts and reconciles large arrays of addresses,
+ * either MAC48 values or packed 6-byte addresses (address i takes the six
+ * bytes starting at octets[6 * i], as in MACAddressBatch).
+ *
+ * Addresses are ordered as their octets (see MAC48::operator<), so that the
+ * addresses of an OUI end up contiguous.
+ *
+ * sort() is a radix sort, moving the addresses between the array and the
+ * caller supplied scratch array of the same size (no heap allocation). Large
+ * arrays are first split into buckets by their most significant bytes (MSD),
+ * until a bucket fits in the caches; each bucket is then sorted by its
+ * remaining bytes from the least significant one (LSD): one pass counting
+ * the occurrences of every byte value at every position, then one stable
+ * scattering pass per byte position. Byte positions holding the same value
+ * in every address of an array or bucket (e.g. the OUI of a single vendor
+ * inventory) are skipped. On AVR boards, where the counts would not fit in
+ * the RAM, sort() is an insertion sort instead (using a single address of
+ * scratch).
+ *
+ * The set operations work on sorted arrays and write to out, which may be
+ * the first array (the results are compacted in place); as for
+ * std::set_intersection and std::set_difference, an address repeated in both
+ * arrays matches at most as many times as it appears in the second one.
+ */
+class MACAddressSort {
+public:
+  static void sort(MAC48 values[], size_t count, MAC48 scratch[]);
+  static void sort(uint8_t octets[], size_t count, uint8_t scratch[]);
+
+#ifdef MACADDRESS_HAS_THREAD
+  /*
+   * Same as sort(), the counting and scattering passes being split among
+   * threads (0: one per hardware thread).
+   */
+  static void sortParallel(MAC48 values[], size_t count, MAC48 scratch[],
+                           unsigned threads = 0);
+  static void sortParallel(uint8_t octets[], size_t count, uint8_t scratch[],
+                           unsigned threads = 0);
+#endif
+
+  /*
+   * Removes the duplicates of a sorted array, keeping the first occurrence.
+   * @return: the number of distinct addresses, moved to the front.
+   */
+  static size_t unique(MAC48 values[], size_t count);
+  static size_t unique(uint8_t octets[], size_t count);
+
+  /*
+   * Writes into out the addresses of the sorted array a found (intersection)
+   * or not found (difference) in the sorted array b; out must be able to hold
+   * count_a addresses.
+   * @return: the number of addresses written.
+   */
+  static size_t intersection(const MAC48 a[], size_t count_a, const MAC48 b[],
+                             size_t count_b, MAC48 out[]);
+  static size_t intersection(const uint8_t a[], size_t count_a,
+                             const uint8_t b[], size_t count_b, uint8_t out[]);
+  static size_t difference(const MAC48 a[], size_t count_a, const MAC48 b[],
+                           size_t count_b, MAC48 out[]);
+  static size_t difference(const uint8_t a[], size_t count_a,
+                           const uint8_t b[], size_t count_b, uint8_t out[]);
+};
+
+#endif // _MACAddressSort_h_
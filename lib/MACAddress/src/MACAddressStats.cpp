@@ -0,0 +1,85 @@
+/*
+ *      @file: MACAddressStats.cpp
+ */
+
+#include "MACAddressStats.h"
+
+#include "MACAddressParser.h"
+
+static_assert(MACAddressStats::STOPPED ==
+                  static_cast<uint8_t>(MACAddressParser::Status::STOPPED),
+              "MACAddressStats::Failure must follow MACAddressParser::Status");
+
+#if MACADDRESS_STATS
+
+MACAddressStats::State MACAddressStats::_counters{};
+
+// Keeps the interrupts away while the counters are copied, restoring their
+// previous state where the core tells it (so that it also works within an
+// interrupt handler)
+struct MACAddressStatsLock {
+#if defined(__AVR__)
+  uint8_t sreg{SREG};
+  MACAddressStatsLock(void) { cli(); }
+  ~MACAddressStatsLock(void) { SREG = sreg; }
+#elif defined(ARDUINO) && defined(__ARM_ARCH_PROFILE) &&                     \
+    __ARM_ARCH_PROFILE == 'M'
+  uint32_t primask;
+  MACAddressStatsLock(void) {
+    __asm__ volatile("mrs %0, primask" : "=r"(primask));
+    __asm__ volatile("cpsid i" ::: "memory");
+  }
+  ~MACAddressStatsLock(void) {
+    __asm__ volatile("msr primask, %0" ::"r"(primask) : "memory");
+  }
+#elif defined(ESP8266)
+  uint32_t ps{xt_rsil(15)};
+  ~MACAddressStatsLock(void) { xt_wsr_ps(ps); }
+#elif defined(ARDUINO)
+  // no portable way to read the state: not for interrupt handlers
+  MACAddressStatsLock(void) { noInterrupts(); }
+  ~MACAddressStatsLock(void) { interrupts(); }
+#else
+  MACAddressStatsLock(void) {} // host: atomic counters, nothing to disable
+#endif
+};
+
+// Both a plain and an atomic counter convert to unsigned long and are
+// assigned from it
+template <typename Counter>
+static void _copy(unsigned long to[], const Counter from[], uint8_t count) {
+  for (uint8_t i = 0; i != count; ++i)
+    to[i] = from[i];
+}
+
+template <typename Counter>
+static void _clear(Counter counters[], uint8_t count) {
+  for (uint8_t i = 0; i != count; ++i)
+    counters[i] = 0;
+}
+
+void MACAddressStats::snapshot(Counters &counters) {
+  MACAddressStatsLock lock;
+  _copy(counters.calls, _counters.calls, OPERATIONS);
+  _copy(counters.ticks, _counters.ticks, OPERATIONS);
+  _copy(counters.failures, _counters.failures, FAILURES);
+  counters.allocations = _counters.allocations;
+  counters.wraps = _counters.wraps;
+}
+
+void MACAddressStats::reset(void) {
+  MACAddressStatsLock lock;
+  _clear(_counters.calls, OPERATIONS);
+  _clear(_counters.ticks, OPERATIONS);
+  _clear(_counters.failures, FAILURES);
+  _counters.allocations = 0;
+  _counters.wraps = 0;
+}
+
+#else
+
+void MACAddressStats::snapshot(Counters &counters) { counters = Counters{}; }
+
+void MACAddressStats::reset(void) {}
+
+#endif // MACADDRESS_STATS
@@ -0,0 +1,162 @@
+#ifndef _MACAddressStats_h_
+#define _MACAddressStats_h_
+
+/*
+ *      @file: MACAddressStats.h
+ *
+ * Optional counters of the library hot paths, selected at compile time.
+ */
+
+#include <Arduino.h>
+
+/*
+ * Build flags (the same for every translation unit, e.g. PlatformIO
+ * build_flags or -DMACADDRESS_STATS=ON on the host CMake build):
+ *   - MACADDRESS_STATS=1 enables the counters; without it every hook below
+ *     expands to nothing and the snapshots are all zeros;
+ *   - MACADDRESS_STATS_TIMING=1 also accumulates the time spent in each
+ *     operation, in ticks of MACADDRESS_STATS_CLOCK(): the time stamp
+ *     counter (cycles) on x86, micros() elsewhere unless redefined (e.g. to
+ *     read the DWT cycle counter of a Cortex-M).
+ */
+#ifndef MACADDRESS_STATS
+#define MACADDRESS_STATS 0
+#endif
+
+#if MACADDRESS_STATS && !defined(ARDUINO)
+#include <atomic>
+#endif
+
+#if MACADDRESS_STATS && MACADDRESS_STATS_TIMING &&                          \
+    !defined(MACADDRESS_STATS_CLOCK)
+#if defined(__x86_64__) || defined(__i386__)
+#define MACADDRESS_STATS_CLOCK() __builtin_ia32_rdtsc()
+#else
+#define MACADDRESS_STATS_CLOCK() micros()
+#endif
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressStats class counts, per kind of operation, the calls made to
+ * the library (parses, formats, extension id arithmetic and comparisons with
+ * strings), the parse failures by reason (see MACAddressParser::Status), the
+ * heap allocations of the growing tables and the extension id wraparounds of
+ * the arithmetic operators.
+ *
+ * Nothing is ever printed: the counters are read by copying them at once
+ * into a snapshot, e.g. from a diagnostics command:
+ *
+ *   MACAddressStats::Counters counters;
+ *   MACAddressStats::snapshot(counters);
+ *   Serial.println(counters.failures[MACAddressStats::BAD_CHAR]);
+ *
+ * On the boards the counters are plain increments and the snapshot is taken
+ * with the interrupts disabled. On the host they are relaxed atomic
+ * increments, so that the threads of the library (e.g.
+ * MACAddressCapture::analyze()) count concurrently without losing counts;
+ * each counter of a snapshot is then exact, but the counters are not read
+ * at the same instant.
+ */
+class MACAddressStats {
+public:
+  enum Operation : uint8_t { PARSE, FORMAT, ARITHMETIC, COMPARE, OPERATIONS };
+
+  // Same order as MACAddressParser::Status (OK is never counted)
+  enum Failure : uint8_t {
+    OK,
+    BAD_CHAR,
+    TOO_MANY_SEPARATORS,
+    TOO_FEW_SEPARATORS,
+    STOPPED, // comparisons with strings ended at the first mismatch
+    FAILURES
+  };
+
+  struct Counters {
+    unsigned long calls[OPERATIONS];
+    unsigned long ticks[OPERATIONS]; // with MACADDRESS_STATS_TIMING only
+    unsigned long failures[FAILURES];
+    unsigned long allocations;
+    unsigned long wraps; // extension ids wrapped around by + and -
+  };
+
+  static bool enabled(void) { return MACADDRESS_STATS; }
+
+  // Copies the current counters (within an interrupt handler too on AVR,
+  // Cortex-M and ESP8266 boards; on the other ones snapshot() and reset()
+  // enable the interrupts on return)
+  static void snapshot(Counters &counters);
+  static void reset(void);
+
+#if MACADDRESS_STATS
+  // Hooks of the library (see the MACADDRESS_STATS_* macros)
+  static void _call(Operation operation) { _add(_counters.calls[operation]); }
+  static void _fail(uint8_t failure) { _add(_counters.failures[failure]); }
+  static void _allocation(void) { _add(_counters.allocations); }
+  static void _wrap(void) { _add(_counters.wraps); }
+
+#if MACADDRESS_STATS_TIMING
+  // Counts a call and the ticks elapsed until the end of its scope
+  class Timer {
+  public:
+    explicit Timer(Operation operation)
+        : _operation{operation}, _start{MACADDRESS_STATS_CLOCK()} {
+      _call(operation);
+    }
+    ~Timer(void) {
+      _add(_counters.ticks[_operation],
+           static_cast<unsigned long>(MACADDRESS_STATS_CLOCK() - _start));
+    }
+
+  private:
+    Operation _operation;
+    unsigned long _start;
+  };
+#endif
+
+private:
+#if defined(ARDUINO)
+  typedef unsigned long Counter;
+  static void _add(Counter &counter, unsigned long n = 1) { counter += n; }
+#else
+  typedef std::atomic<unsigned long> Counter;
+  static void _add(Counter &counter, unsigned long n = 1) {
+    counter.fetch_add(n, std::memory_order_relaxed);
+  }
+#endif
+
+  // Same fields as Counters
+  struct State {
+    Counter calls[OPERATIONS];
+    Counter ticks[OPERATIONS];
+    Counter failures[FAILURES];
+    Counter allocations;
+    Counter wraps;
+  };
+
+  static State _counters;
+#endif
+};
+
+#if MACADDRESS_STATS
+#if MACADDRESS_STATS_TIMING
+#define MACADDRESS_STATS_SCOPE(operation)                                      \
+  MACAddressStats::Timer _stats_timer { MACAddressStats::operation }
+#else
+#define MACADDRESS_STATS_SCOPE(operation)                                      \
+  MACAddressStats::_call(MACAddressStats::operation)
+#endif
+#define MACADDRESS_STATS_FAILURE(status)                                       \
+  do {                                                                         \
+    if (static_cast<uint8_t>(status) != MACAddressStats::OK)                   \
+      MACAddressStats::_fail(static_cast<uint8_t>(status));                    \
+  } while (0)
+#define MACADDRESS_STATS_ALLOCATION() MACAddressStats::_allocation()
+#define MACADDRESS_STATS_WRAP() MACAddressStats::_wrap()
+#else
+#define MACADDRESS_STATS_SCOPE(operation)
+#define MACADDRESS_STATS_FAILURE(status)
+#define MACADDRESS_STATS_ALLOCATION()
+#define MACADDRESS_STATS_WRAP()
+#endif
+
+#endif // _MACAddressStats_h_
@@ -0,0 +1,100 @@
+/*
+ *      @file: MACAddressStorage.cpp
+ */
+
+#include "MACAddressStorage.h"
+
+#ifdef MACADDRESS_HAS_EEPROM
+
+#include <EEPROM.h>
+
+bool MACAddressEEPROMStorage::read(size_t offset, uint8_t data[],
+                                   size_t length) {
+  if (offset > _length || length > _length - offset)
+    return false;
+
+  for (size_t i = 0; i != length; ++i)
+    data[i] = EEPROM.read(static_cast<int>(_offset + offset + i));
+  return true;
+}
+
+bool MACAddressEEPROMStorage::write(size_t offset, const uint8_t data[],
+                                    size_t length) {
+  if (offset > _length || length > _length - offset)
+    return false;
+
+  // every byte written costs a few ms (and wears the cell): skip the ones
+  // already holding their value
+  for (size_t i = 0; i != length; ++i) {
+    const int address = static_cast<int>(_offset + offset + i);
+    if (EEPROM.read(address) != data[i])
+      EEPROM.write(address, data[i]);
+  }
+#if defined(ESP8266) || defined(ESP32)
+  return EEPROM.commit();
+#else
+  return true;
+#endif
+}
+
+#endif // MACADDRESS_HAS_EEPROM
+
+#if !defined(ARDUINO)
+
+bool MACAddressFileStorage::open(const char *path, size_t length) {
+  close();
+  _file = fopen(path, "r+b");
+  if (_file == nullptr)
+    _file = fopen(path, "w+b");
+  if (_file == nullptr)
+    return false;
+
+  // erase the bytes missing from a new or shorter file
+  if (fseek(_file, 0, SEEK_END) != 0) {
+    close();
+    return false;
+  }
+  const long current = ftell(_file);
+  for (long i = current; i >= 0 && static_cast<size_t>(i) < length; ++i)
+    if (fputc(0xFF, _file) == EOF) {
+      close();
+      return false;
+    }
+  if (fflush(_file) != 0) {
+    close();
+    return false;
+  }
+
+  _length = length;
+  _writes = 0;
+  _bytes = 0;
+  return true;
+}
+
+void MACAddressFileStorage::close(void) {
+  if (_file != nullptr)
+    fclose(_file);
+  _file = nullptr;
+  _length = 0;
+}
+
+bool MACAddressFileStorage::read(size_t offset, uint8_t data[],
+                                 size_t length) {
+  return _file != nullptr && offset <= _length &&
+         length <= _length - offset &&
+         fseek(_file, static_cast<long>(offset), SEEK_SET) == 0 &&
+         fread(data, 1, length, _file) == length;
+}
+
+bool MACAddressFileStorage::write(size_t offset, const uint8_t data[],
+                                  size_t length) {
+  if (_file == nullptr || offset > _length || length > _length - offset)
+    return false;
+
+  ++_writes;
+  _bytes += length;
+  return fseek(_file, static_cast<long>(offset), SEEK_SET) == 0 &&
+         fwrite(data, 1, length, _file) == length && fflush(_file) == 0;
+}
+
+#endif // !ARDUINO
@@ -0,0 +1,95 @@
+#ifndef _MACAddressStorage_h_
+#define _MACAddressStorage_h_
+
+/*
+ *      @file: MACAddressStorage.h
+ *
+ * MACAddressEEPROMStorage is only available on the boards whose core provides
+ * the EEPROM library, MACAddressFileStorage only on hosts.
+ */
+
+#include <Arduino.h>
+
+#if defined(ARDUINO) && defined(__has_include)
+#if __has_include(<EEPROM.h>)
+#define MACADDRESS_HAS_EEPROM 1
+#endif
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressStorage class is the interface of a small non-volatile memory
+ * holding the state of a MACAddressGenerator: a range of bytes read and
+ * written at given offsets.
+ *
+ * Erased (never written) bytes read as 0xFF, as in an EEPROM.
+ */
+class MACAddressStorage {
+public:
+  virtual ~MACAddressStorage(void) {}
+
+  // Number of bytes of the storage
+  virtual size_t size(void) const = 0;
+
+  // Both return false if [offset, offset + length) does not fit or on an I/O
+  // error
+  virtual bool read(size_t offset, uint8_t data[], size_t length) = 0;
+  virtual bool write(size_t offset, const uint8_t data[], size_t length) = 0;
+};
+
+#ifdef MACADDRESS_HAS_EEPROM
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressEEPROMStorage class is a region of the EEPROM of the board
+ * (the emulated one on ESP boards, where EEPROM.begin() must have been
+ * called). Bytes already holding the value written are not written again.
+ */
+class MACAddressEEPROMStorage : public MACAddressStorage {
+public:
+  MACAddressEEPROMStorage(size_t offset, size_t length)
+      : _offset{offset}, _length{length} {}
+
+  virtual size_t size(void) const { return _length; }
+  virtual bool read(size_t offset, uint8_t data[], size_t length);
+  virtual bool write(size_t offset, const uint8_t data[], size_t length);
+
+private:
+  const size_t _offset;
+  const size_t _length;
+};
+#endif // MACADDRESS_HAS_EEPROM
+
+#if !defined(ARDUINO)
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressFileStorage class keeps the bytes in a file of the host (for
+ * tests and benchmarks of the boards code, or a provisioning server), created
+ * erased if missing; every write is flushed.
+ */
+class MACAddressFileStorage : public MACAddressStorage {
+public:
+  MACAddressFileStorage(void) {}
+  ~MACAddressFileStorage(void) { close(); }
+
+  MACAddressFileStorage(const MACAddressFileStorage &) = delete;
+  MACAddressFileStorage &operator=(const MACAddressFileStorage &) = delete;
+
+  // Opens (or creates) path as a storage of length bytes
+  bool open(const char *path, size_t length);
+  void close(void);
+  bool isOpen(void) const { return _file != nullptr; }
+
+  virtual size_t size(void) const { return _length; }
+  virtual bool read(size_t offset, uint8_t data[], size_t length);
+  virtual bool write(size_t offset, const uint8_t data[], size_t length);
+
+  // Number of write() calls and bytes written since open()
+  unsigned long writes(void) const { return _writes; }
+  unsigned long bytes(void) const { return _bytes; }
+
+private:
+  FILE *_file{nullptr};
+  size_t _length{0};
+  unsigned long _writes{0};
+  unsigned long _bytes{0};
+};
+#endif
+
+#endif // _MACAddressStorage_h_
@@ -0,0 +1,93 @@
+#ifndef _MACAddressView_h_
+#define _MACAddressView_h_
+
+/*
+ *      @file: MACAddressView.h
+ */
+
+#include <Arduino.h>
+
+#include "MAC48.h"
+#include "MACAddressFormat.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * The MACAddressView class reads an address in place: it holds a pointer to
+ * six bytes owned by someone else (e.g. the destination and source fields of
+ * an Ethernet frame in a receive buffer) and never copies nor owns them.
+ *
+ * It offers the read API of MACAddress (OUI and extension id getters,
+ * comparisons, I/G and U/L bit tests, formatting) and converts implicitly to
+ * const uint8_t *, so that it can be compared with a MACAddress through
+ * MACAddress::operator==(const uint8_t *):
+ *
+ *   MACAddressView destination{frame}, source{frame + 6};
+ *   if (gateway == source && !destination.isMulticast())
+ *     ...
+ *
+ * The bytes must outlive the view; writing them changes what the view reads.
+ */
+class MACAddressView {
+public:
+  explicit MACAddressView(const uint8_t octets[]) : _octets{octets} {}
+
+  const uint8_t *data(void) const { return _octets; }
+  operator const uint8_t *(void) const { return _octets; }
+  uint8_t operator[](uint8_t i) const { return _octets[i]; }
+
+  // Lean copy of the address (see MAC48)
+  MAC48 toMAC48(void) const { return MAC48::fromOctets(_octets); }
+
+  uint32_t getOUI24(void) const { return toMAC48().getOUI24(); }
+  uint32_t getExtensionId24(void) const { return toMAC48().getExtensionId24(); }
+  uint32_t getOUI20(void) const { return toMAC48().getOUI20(); }
+  uint32_t getExtensionId28(void) const { return toMAC48().getExtensionId28(); }
+  uint32_t getOUI12(void) const { return toMAC48().getOUI12(); }
+  uint64_t getExtensionId36(void) const { return toMAC48().getExtensionId36(); }
+  uint64_t getExtensionId(MA ma) const {
+    return toMAC48().getExtensionId(ma);
+  }
+
+  bool isMulticast(void) const { return _octets[0] & 0x01; }
+  bool isUnicast(void) const { return !isMulticast(); }
+  bool isLocal(void) const { return _octets[0] & 0x02; }
+  bool isUniversal(void) const { return !isLocal(); }
+  bool isBroadcast(void) const { return toMAC48().isBroadcast(); }
+
+  bool operator==(const MACAddressView &view) const {
+    return 0 == memcmp(_octets, view._octets, 6);
+  }
+  bool operator!=(const MACAddressView &view) const {
+    return !(*this == view);
+  }
+  bool operator<(const MACAddressView &view) const {
+    return memcmp(_octets, view._octets, 6) < 0;
+  }
+  bool operator<=(const MACAddressView &view) const { return !(view < *this); }
+  bool operator>(const MACAddressView &view) const { return view < *this; }
+  bool operator>=(const MACAddressView &view) const { return !(*this < view); }
+
+  bool operator==(const uint8_t *octets) const {
+    return 0 == memcmp(_octets, octets, 6);
+  }
+  bool operator!=(const uint8_t *octets) const { return !(*this == octets); }
+  bool operator==(MAC48 mac) const { return toMAC48() == mac; }
+  bool operator!=(MAC48 mac) const { return toMAC48() != mac; }
+
+  // Writes the address into [first, last) (see MAC48::toChars)
+  char *toChars(char *first, char *last,
+                Representation representation =
+                    Representation::COMMON_FULL) const {
+    return toMAC48().toChars(first, last, representation);
+  }
+
+  // Printable form of the address: Serial.print(view.as())
+  MACAddressText as(Representation representation =
+                        Representation::COMMON_FULL) const {
+    return MACAddressText{_octets, representation};
+  }
+
+private:
+  const uint8_t *_octets;
+};
+
+#endif // _MACAddressView_h_
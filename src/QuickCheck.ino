@@ -269,6 +269,26 @@ void errorsCheck(void) {
   Serial.println(rc ? "true" : "false");
 }
 
+void arithmeticCheck(void) {
+  Serial.println();
+  Serial.println(F("Arithmetic Check"));
+  Serial.println();
+
+  // MA-M: the extension id (28 bits) wraps within the block, the results of
+  // + and - keep the MA setting
+  MACAddress mac{"AB:CD:EF:FF:FF:FF"};
+  mac.ma = MA::M;
+  MACAddress next = mac + 1;
+  Serial.print(F("\t(MA::M) + 1: "));
+  Serial.print(next); // AB:CD:E0:00:00:00
+  Serial.print(F("  "));
+  Serial.println(next.ma == MA::M ? "true" : "false");
+
+  MACAddress lean{mac.toMAC48()};
+  Serial.print(F("\t(MAC48)    : "));
+  Serial.println(lean);
+}
+
 void setup(void) {
   Serial.begin(BAUD_RATE);
   delay(20);
@@ -276,6 +296,7 @@ void setup(void) {
   constructorsCheck();
   streamOutputCheck();
   errorsCheck();
+  arithmeticCheck();
 }
 
 void loop(void) {}